@@ -119,16 +119,10 @@ Constraint::Constraint(const Expression_AST<Real> & exp, const Real & b)
 
 Constraint::Constraint(const std::string & strExpression)
 {
-	expression_ast_setting.clear();
+	Expression_AST<Interval> tmp;
+	parseExpressionAST(tmp, strExpression, stateVars);
 
-	std::string prefix(str_prefix_expression_ast);
-	std::string suffix(str_suffix);
-
-	expression_ast_setting.strExpression = prefix + strExpression + suffix;
-
-	parseExpression();
-
-	expression_ast_setting.result.toReal(expression);
+	tmp.toReal(expression);
 }
 
 Constraint::Constraint(const Constraint & constraint)
@@ -14,6 +14,9 @@ Variables tvPars;
 Continuous_Reachability_Problem_Description problem_description;
 Continuous_Reachability reachability_for_outputFile;
 
+Refinement_Statistics flowstar::refinementStats;
+Stepsize_Statistics flowstar::stepsizeStats;
+
 
 
 Symbolic_Remainder::Symbolic_Remainder()
@@ -22,16 +25,27 @@ Symbolic_Remainder::Symbolic_Remainder()
 
 Symbolic_Remainder::Symbolic_Remainder(const Flowpipe & initial_set)
 {
-	scalars.resize(initial_set.tmvPre.tms.size(), 1);
-	initial_set.tmv.Expansion(polynomial_of_initial_set);
+	reset(initial_set);
 }
 
 Symbolic_Remainder::Symbolic_Remainder(const Symbolic_Remainder & symbolic_remainder)
 {
-	J							= symbolic_remainder.J;
-	Phi_L						= symbolic_remainder.Phi_L;
-	scalars						= symbolic_remainder.scalars;
-	polynomial_of_initial_set	= symbolic_remainder.polynomial_of_initial_set;
+	J								= symbolic_remainder.J;
+	Phi_L							= symbolic_remainder.Phi_L;
+	scalars							= symbolic_remainder.scalars;
+	polynomial_of_initial_set		= symbolic_remainder.polynomial_of_initial_set;
+	Phi_L_float						= symbolic_remainder.Phi_L_float;
+	polynomial_of_initial_set_float	= symbolic_remainder.polynomial_of_initial_set_float;
+}
+
+Symbolic_Remainder::Symbolic_Remainder(Symbolic_Remainder && symbolic_remainder) noexcept
+{
+	J.swap(symbolic_remainder.J);
+	Phi_L.swap(symbolic_remainder.Phi_L);
+	scalars.swap(symbolic_remainder.scalars);
+	polynomial_of_initial_set.swap(symbolic_remainder.polynomial_of_initial_set);
+	Phi_L_float.swap(symbolic_remainder.Phi_L_float);
+	polynomial_of_initial_set_float.swap(symbolic_remainder.polynomial_of_initial_set_float);
 }
 
 Symbolic_Remainder::~Symbolic_Remainder()
@@ -45,8 +59,16 @@ void Symbolic_Remainder::reset(const Flowpipe & initial_set)
 
 	initial_set.tmv.Expansion(polynomial_of_initial_set);
 
+	polynomial_of_initial_set_float.resize(polynomial_of_initial_set.size());
+
+	for(unsigned int i=0; i<polynomial_of_initial_set.size(); ++i)
+	{
+		polynomial_of_initial_set[i].toFloat(polynomial_of_initial_set_float[i]);
+	}
+
 	J.clear();
 	Phi_L.clear();
+	Phi_L_float.clear();
 }
 
 Symbolic_Remainder & Symbolic_Remainder::operator = (const Symbolic_Remainder & symbolic_remainder)
@@ -54,10 +76,24 @@ Symbolic_Remainder & Symbolic_Remainder::operator = (const Symbolic_Remainder &
 	if(this == &symbolic_remainder)
 		return *this;
 
-	J							= symbolic_remainder.J;
-	Phi_L						= symbolic_remainder.Phi_L;
-	scalars						= symbolic_remainder.scalars;
-	polynomial_of_initial_set	= symbolic_remainder.polynomial_of_initial_set;
+	J								= symbolic_remainder.J;
+	Phi_L							= symbolic_remainder.Phi_L;
+	scalars							= symbolic_remainder.scalars;
+	polynomial_of_initial_set		= symbolic_remainder.polynomial_of_initial_set;
+	Phi_L_float						= symbolic_remainder.Phi_L_float;
+	polynomial_of_initial_set_float	= symbolic_remainder.polynomial_of_initial_set_float;
+
+	return *this;
+}
+
+Symbolic_Remainder & Symbolic_Remainder::operator = (Symbolic_Remainder && symbolic_remainder) noexcept
+{
+	J.swap(symbolic_remainder.J);
+	Phi_L.swap(symbolic_remainder.Phi_L);
+	scalars.swap(symbolic_remainder.scalars);
+	polynomial_of_initial_set.swap(symbolic_remainder.polynomial_of_initial_set);
+	Phi_L_float.swap(symbolic_remainder.Phi_L_float);
+	polynomial_of_initial_set_float.swap(symbolic_remainder.polynomial_of_initial_set_float);
 
 	return *this;
 }
@@ -161,6 +197,11 @@ void Computational_Setting::setQueueSize(const unsigned int m)
 	tm_setting.queue_size = m;
 }
 
+void Computational_Setting::setRefinementTolerance(const std::vector<double> & tolerance)
+{
+	tm_setting.refinement_tolerance = tolerance;
+}
+
 bool Computational_Setting::resetOrder(const unsigned int order)
 {
 	bool bValid = tm_setting.resetOrder(order);
@@ -225,6 +266,229 @@ Computational_Setting & Computational_Setting::operator = (const Computational_S
 
 
 
+Refinement_Statistics::Refinement_Statistics()
+{
+	clear();
+}
+
+Refinement_Statistics::~Refinement_Statistics()
+{
+}
+
+void Refinement_Statistics::clear()
+{
+	steps = 0;
+	iterations = 0;
+	early_exits = 0;
+	capped = 0;
+	extrapolations = 0;
+	failed_extrapolations = 0;
+}
+
+
+
+Stepsize_Statistics::Stepsize_Statistics()
+{
+	clear();
+}
+
+Stepsize_Statistics::~Stepsize_Statistics()
+{
+}
+
+void Stepsize_Statistics::clear()
+{
+	accepted = 0;
+	rejected = 0;
+}
+
+
+
+Remainder_Refinement::Remainder_Refinement(const Taylor_Model_Computation_Setting & tm_setting, const unsigned int d) : tolerance(tm_setting.refinement_tolerance)
+{
+	lastGain.resize(d, 0);
+	rate.resize(d, 0);
+	dim = d;
+	iterations = 0;
+	checked = 0;
+	bContracting = false;
+	bContinue = false;
+	bAccelerate = tolerance.size() > 0;
+	bExtrapolated = false;
+}
+
+Remainder_Refinement::~Remainder_Refinement()
+{
+	++refinementStats.steps;
+	refinementStats.iterations += iterations;
+
+	if(bContinue)
+	{
+		if(iterations > MAX_REFINEMENT_STEPS)
+		{
+			++refinementStats.capped;
+		}
+	}
+	else if(bContracting && checked == dim)
+	{
+		++refinementStats.early_exits;
+	}
+}
+
+void Remainder_Refinement::next()
+{
+	++iterations;
+	checked = 0;
+	bContracting = false;
+	bContinue = false;
+}
+
+bool Remainder_Refinement::shrinking(const unsigned int i, const Interval & oldRemainder, const Interval & newRemainder)
+{
+	++checked;
+
+	double ratio = oldRemainder.widthRatio(newRemainder);
+
+	if(!(ratio <= STOP_RATIO))
+	{
+		lastGain[i] = 0;
+		rate[i] = 0;
+		return false;
+	}
+
+	bContracting = true;
+
+	if(i < tolerance.size() && tolerance[i] > 0)
+	{
+		double width = newRemainder.width();
+		double gain = oldRemainder.width() - width;
+		rate[i] = lastGain[i] > 0 ? gain / lastGain[i] : 0;
+		lastGain[i] = gain;
+
+		double r = rate[i] > 0 ? rate[i] : ratio;
+
+		// the gains of a geometric contraction add up to gain * r / (1 - r), and never to more than the width
+		double predicted = width;
+
+		if(r < 1)
+		{
+			predicted = std::min(predicted, gain * r / (1 - r));
+		}
+
+		if(predicted < tolerance[i])
+		{
+			return false;
+		}
+	}
+
+	bContinue = true;
+	return true;
+}
+
+// moves the remainders of the dimensions with a known contraction rate toward their predicted limits
+bool Remainder_Refinement::extrapolate(std::vector<Interval> & remainders, const std::vector<Interval> & oldRemainders)
+{
+	bool bMoved = false;
+
+	for(unsigned int i=0; i<dim; ++i)
+	{
+		if(!(rate[i] > 0 && rate[i] < 1))
+		{
+			continue;
+		}
+
+		double share = EXTRAPOLATION_SHARE * rate[i] / (1 - rate[i]);
+		double lo = remainders[i].inf() + (remainders[i].inf() - oldRemainders[i].inf()) * share;
+		double up = remainders[i].sup() - (oldRemainders[i].sup() - remainders[i].sup()) * share;
+
+		if(lo <= up)
+		{
+			remainders[i] = Interval(lo, up);
+			bMoved = true;
+
+			// the gain of the next iteration is not comparable to the last one
+			lastGain[i] = 0;
+			rate[i] = 0;
+		}
+	}
+
+	return bMoved;
+}
+
+// takes the remainders of the next iteration, and returns whether the refinement goes on
+template <class DATA_TYPE>
+bool Remainder_Refinement::update(TaylorModelVec<DATA_TYPE> & x, const std::vector<Interval> & newRemainders)
+{
+	if(bExtrapolated)
+	{
+		bExtrapolated = false;
+
+		// the extrapolated remainders are only kept if the Picard operator maps them into themselves
+		for(unsigned int i=0; i<dim; ++i)
+		{
+			if(!newRemainders[i].subseteq(x.tms[i].remainder))
+			{
+				++refinementStats.failed_extrapolations;
+				bAccelerate = false;
+
+				for(unsigned int j=0; j<dim; ++j)
+				{
+					x.tms[j].remainder = verified[j];
+					lastGain[j] = 0;
+					rate[j] = 0;
+				}
+
+				return true;
+			}
+		}
+
+		++refinementStats.extrapolations;
+	}
+
+	std::vector<Interval> oldRemainders(dim);
+	bool bRefine = false;
+
+	for(unsigned int i=0; i<dim; ++i)
+	{
+		if(newRemainders[i].subseteq(x.tms[i].remainder))
+		{
+			if(shrinking(i, x.tms[i].remainder, newRemainders[i]))
+			{
+				bRefine = true;
+			}
+
+			oldRemainders[i] = x.tms[i].remainder;
+			x.tms[i].remainder = newRemainders[i];
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	// only extrapolate if there is an iteration left to verify the result
+	if(bRefine && bAccelerate && iterations <= MAX_REFINEMENT_STEPS)
+	{
+		std::vector<Interval> remainders(newRemainders);
+
+		if(extrapolate(remainders, oldRemainders))
+		{
+			verified = newRemainders;
+
+			for(unsigned int i=0; i<dim; ++i)
+			{
+				x.tms[i].remainder = remainders[i];
+			}
+
+			bExtrapolated = true;
+		}
+	}
+
+	return bRefine;
+}
+
+
+
 Flowpipe::Flowpipe()
 {
 }
@@ -255,6 +519,10 @@ Flowpipe::Flowpipe(const Flowpipe & flowpipe)
 	domain = flowpipe.domain;
 }
 
+Flowpipe::Flowpipe(Flowpipe && flowpipe) noexcept : tmvPre(std::move(flowpipe.tmvPre)), tmv(std::move(flowpipe.tmv)), domain(std::move(flowpipe.domain))
+{
+}
+
 Flowpipe::~Flowpipe()
 {
 }
@@ -291,7 +559,7 @@ void Flowpipe::compose(TaylorModelVec<Real> & result, const std::vector<unsigned
 	{
 		TaylorModel<Real> tmTmp;
 		tmvPre.tms[outputAxes[i]].insert_ctrunc(tmTmp, tmv, tmvPolyRange, domain, order, cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -319,7 +587,7 @@ void Flowpipe::compose_normal(TaylorModelVec<Real> & result, const std::vector<u
 	{
 		TaylorModel<Real> tmTmp;
 		tmvPre.tms[outputAxes[i]].insert_ctrunc_normal(tmTmp, tmv, tmvPolyRange, step_exp_table, domain.size(), order, cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -511,19 +779,55 @@ Flowpipe & Flowpipe::operator = (const Flowpipe & flowpipe)
 	return *this;
 }
 
-int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Expression_AST<Real> > & ode, const Taylor_Model_Computation_Setting & tm_setting, const std::vector<Constraint> & invariant, const Global_Computation_Setting & g_setting) const
+Flowpipe & Flowpipe::operator = (Flowpipe && flowpipe) noexcept
+{
+	tmvPre = std::move(flowpipe.tmvPre);
+	tmv = std::move(flowpipe.tmv);
+	domain.swap(flowpipe.domain);
+
+	return *this;
+}
+
+// The scaling factors of a dimension whose range has the magnitude sup, it returns invS as it is kept in the symbolic remainder.
+// With Float coefficients invS is rounded downward, so that the scaled range stays in [-1,1], and S encloses 1/invS.
+static Real scaling_factors(Real & S, Real & invS, const Real & sup)
+{
+	S = sup;
+	invS = 1/sup;
+
+	return invS;
+}
+
+static Real scaling_factors(Float & S, Float & invS, const Real & sup)
+{
+	double d = sup.getValue_RNDU();
+	double q = 1 / d;
+
+	if(std::fma(q, d, -1) > 0)
+	{
+		q = std::nextafter(q, 0.0);
+	}
+
+	invS = q;
+	S = Float(1) / invS;
+
+	return Real(q);
+}
+
+// A flowpipe step with the coefficient type DATA_TYPE. The rounding errors of Float coefficients are swept into the remainders.
+template <class DATA_TYPE>
+static int deterministic_step(TaylorModelVec<DATA_TYPE> & resultPre, TaylorModelVec<DATA_TYPE> & resultTmv, const TaylorModelVec<DATA_TYPE> & tmvPre, const TaylorModelVec<DATA_TYPE> & tmv, const std::vector<Interval> & domain, const std::vector<Expression_AST<Real> > & ode, const Taylor_Model_Computation_Setting & tm_setting, const std::vector<Constraint> & invariant, const Global_Computation_Setting & g_setting)
 {
 	unsigned int rangeDim = ode.size();
 	unsigned int rangeDimExt = rangeDim + 1;
 	Interval intUnit(-1,1);
-	result.clear();
 
 	// evaluate the the initial set x0
-	TaylorModelVec<Real> tmv_of_x0;
+	TaylorModelVec<DATA_TYPE> tmv_of_x0;
 	tmvPre.evaluate_time(tmv_of_x0, tm_setting.step_end_exp_table);
 
 	// the center point of x0's polynomial part
-	std::vector<Real> const_of_x0;
+	std::vector<DATA_TYPE> const_of_x0;
 	tmv_of_x0.constant(const_of_x0);
 
 	for(unsigned int i=0; i<rangeDim; ++i)
@@ -533,14 +837,14 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		const_of_x0[i] += c;
 	}
 
-	TaylorModelVec<Real> tmv_c0(const_of_x0, rangeDimExt);
+	TaylorModelVec<DATA_TYPE> tmv_c0(const_of_x0, rangeDimExt);
 
 	// introduce a new variable r0 such that x0 = c0 + A*r0, then r0 is origin-centered
 	tmv_of_x0.rmConstant();
 
 	std::vector<Interval> tmvPolyRange;
 	tmv.polyRangeNormal(tmvPolyRange, tm_setting.step_end_exp_table);
-	tmv_of_x0.insert_ctrunc_normal(result.tmv, tmv, tmvPolyRange, tm_setting.step_end_exp_table, domain.size(), tm_setting.order, tm_setting.cutoff_threshold);
+	tmv_of_x0.insert_ctrunc_normal(resultTmv, tmv, tmvPolyRange, tm_setting.step_end_exp_table, domain.size(), tm_setting.order, tm_setting.cutoff_threshold);
 
 	std::vector<Interval> range_of_x0;
 
@@ -548,7 +852,7 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 	if(invariant.size() > 0)
 	{
 		std::vector<Interval> polyRangeOfx0;
-		result.tmv.polyRangeNormal(polyRangeOfx0, tm_setting.step_end_exp_table);
+		resultTmv.polyRangeNormal(polyRangeOfx0, tm_setting.step_end_exp_table);
 
 		std::vector<Interval> intVecTmp(rangeDim);
 		for(int i=0; i<rangeDim; ++i)
@@ -559,7 +863,7 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		std::vector<Interval> contracted_remainders(rangeDim);
 		for(int i=0; i<rangeDim; ++i)
 		{
-			contracted_remainders[i] = result.tmv.tms[i].remainder;
+			contracted_remainders[i] = resultTmv.tms[i].remainder;
 		}
 
 		int res = contract_remainder(intVecTmp, contracted_remainders, invariant);
@@ -571,18 +875,18 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 
 		for(int i=0; i<rangeDim; ++i)
 		{
-			result.tmv.tms[i].remainder = contracted_remainders[i];
-			range_of_x0.push_back(polyRangeOfx0[i] + result.tmv.tms[i].remainder);
+			resultTmv.tms[i].remainder = contracted_remainders[i];
+			range_of_x0.push_back(polyRangeOfx0[i] + resultTmv.tms[i].remainder);
 		}
 	}
 	else
 	{
-		result.tmv.intEvalNormal(range_of_x0, tm_setting.step_end_exp_table);
+		resultTmv.intEvalNormal(range_of_x0, tm_setting.step_end_exp_table);
 	}
 
 
 	// Compute the scaling matrix S.
-	std::vector<Real> S, invS;
+	std::vector<DATA_TYPE> S, invS;
 
 	for(int i=0; i<rangeDim; ++i)
 	{
@@ -596,23 +900,29 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		}
 		else
 		{
-			S.push_back(sup);
-			invS.push_back(1/sup);
+			DATA_TYPE s, s_inv;
+			scaling_factors(s, s_inv, sup);
+			S.push_back(s);
+			invS.push_back(s_inv);
 			range_of_x0[i] = intUnit;
 		}
 	}
 
-	result.tmv.scale_assign(invS);
-//	result.tmv.cutoff_normal(tm_setting.step_end_exp_table, tm_setting.cutoff_threshold);
+	resultTmv.scale_assign(invS);
 
-	TaylorModelVec<Real> new_x0(S);
+	// only Float coefficients have rounding errors
+	std::vector<Interval> errors;
+	resultTmv.roundoff_normal(errors, tm_setting.step_end_exp_table);
+//	resultTmv.cutoff_normal(tm_setting.step_end_exp_table, tm_setting.cutoff_threshold);
+
+	TaylorModelVec<DATA_TYPE> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
+	TaylorModelVec<DATA_TYPE> x;
+	Incremental_Picard<DATA_TYPE> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	// the candidate is given by the values of its coefficients, their errors go with the remainders reset below
+	x.roundoff_normal(errors, tm_setting.step_exp_table);
 
 //	x.cutoff(tm_setting.cutoff_threshold);
 
@@ -623,7 +933,7 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		x.tms[i].remainder = tm_setting.remainder_estimation[i];
 	}
 
-	TaylorModelVec<Real> tmvTmp;
+	TaylorModelVec<DATA_TYPE> tmvTmp;
 	std::list<Interval> intermediate_ranges;
 
 	x.Picard_ctrunc_normal(tmvTmp, new_x0, ode, tm_setting.step_exp_table, rangeDimExt, tm_setting.order, tm_setting.cutoff_threshold, intermediate_ranges, g_setting);
@@ -632,7 +942,7 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 	std::vector<Interval> intDifferences;
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
-		Polynomial<Real> polyTmp;
+		Polynomial<DATA_TYPE> polyTmp;
 		polyTmp = tmvTmp.tms[i].expansion - x.tms[i].expansion;
 
 		Interval I;
@@ -665,10 +975,12 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		}
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -677,31 +989,47 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
-	result.domain = domain;
-	result.domain[0] = tm_setting.step_exp_table[1];
+	resultPre = std::move(x);
 
 	return 1;
 }
 
+int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Expression_AST<Real> > & ode, const Taylor_Model_Computation_Setting & tm_setting, const std::vector<Constraint> & invariant, const Global_Computation_Setting & g_setting) const
+{
+	result.clear();
+
+	int res;
+
+	if(roundingErrorSweep)
+	{
+		TaylorModelVec<Float> floatPre, floatTmv, resultPre, resultTmv;
+		tmvPre.toFloat(floatPre);
+		tmv.toFloat(floatTmv);
+
+		res = deterministic_step(resultPre, resultTmv, floatPre, floatTmv, domain, ode, tm_setting, invariant, g_setting);
+
+		resultPre.toReal(result.tmvPre);
+		resultTmv.toReal(result.tmv);
+	}
+	else
+	{
+		res = deterministic_step(result.tmvPre, result.tmv, tmvPre, tmv, domain, ode, tm_setting, invariant, g_setting);
+	}
+
+	if(res == 1)
+	{
+		result.domain = domain;
+		result.domain[0] = tm_setting.step_exp_table[1];
+	}
+
+	return res;
+}
+
 int Flowpipe::advance_nondeterministic(Flowpipe & result, const std::vector<Expression_AST<Interval> > & ode, const Taylor_Model_Computation_Setting & tm_setting, const std::vector<Constraint> & invariant, const Global_Computation_Setting & g_setting) const
 {
 	unsigned int rangeDim = ode.size();
@@ -798,12 +1126,9 @@ int Flowpipe::advance_nondeterministic(Flowpipe & result, const std::vector<Expr
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 //	x.cutoff(tm_setting.cutoff_threshold);
 
@@ -856,10 +1181,12 @@ int Flowpipe::advance_nondeterministic(Flowpipe & result, const std::vector<Expr
 		}
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -868,25 +1195,12 @@ int Flowpipe::advance_nondeterministic(Flowpipe & result, const std::vector<Expr
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -989,12 +1303,9 @@ int Flowpipe::advance_deterministic_adaptive_stepsize(Flowpipe & result, const s
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 //	x.cutoff(tm_setting.cutoff_threshold);
 
@@ -1026,56 +1337,75 @@ int Flowpipe::advance_deterministic_adaptive_stepsize(Flowpipe & result, const s
 	}
 
 	// add the uncertainties and the cutoff intervals onto the result
+	double ratio = 0;
+
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
 		tmvTmp.tms[i].remainder += intDifferences[i];
+		ratio = std::max(ratio, Stepsize_Controller::ratio(tmvTmp.tms[i].remainder, x.tms[i].remainder));
 
 		if( ! tmvTmp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 		{
 			bfound = false;
-			break;
 		}
 	}
 
 	for(; !bfound;)
 	{
 		bfound = true;
-		double newStep = tm_setting.step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
+		++stepsizeStats.rejected;
 
-		if(newStep < tm_setting.step_min)
+		double step = tm_setting.step_exp_table[1].sup();
+
+		if(step <= tm_setting.step_min)
 		{
 			return 0;
 		}
 
+		// reduce the time step size as predicted from the remainders of the rejected one
+		double newStep = tm_setting.step_controller.reject(step, ratio, tm_setting.order);
+
+		if(newStep < tm_setting.step_min)
+		{
+			newStep = tm_setting.step_min;
+		}
+
 		tm_setting.setStepsize(newStep, tm_setting.order);
 
 		intermediate_ranges.clear();
 		x.Picard_ctrunc_normal(tmvTmp, new_x0, ode, tm_setting.step_exp_table, rangeDimExt, tm_setting.order, tm_setting.cutoff_threshold, intermediate_ranges, g_setting);
 
 		// recompute the interval evaluation of the polynomial differences
+		ratio = 0;
+
 		for(int i=0; i<rangeDim; ++i)
 		{
 			polyDifferences[i].intEvalNormal(intDifferences[i], tm_setting.step_exp_table);
 
 			tmvTmp.tms[i].remainder += intDifferences[i];
+			ratio = std::max(ratio, Stepsize_Controller::ratio(tmvTmp.tms[i].remainder, x.tms[i].remainder));
 
 			if( ! tmvTmp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 			{
 				bfound = false;
-				break;
 			}
 		}
 	}
 
+	++stepsizeStats.accepted;
+	tm_setting.step_controller.accept(tm_setting.step_exp_table[1].sup(), ratio, tm_setting.order);
+
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
 		x.tms[i].remainder = tmvTmp.tms[i].remainder;
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -1084,25 +1414,12 @@ int Flowpipe::advance_deterministic_adaptive_stepsize(Flowpipe & result, const s
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -1204,12 +1521,9 @@ int Flowpipe::advance_nondeterministic_adaptive_stepsize(Flowpipe & result, cons
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 	bool bfound = true;
 
@@ -1239,56 +1553,75 @@ int Flowpipe::advance_nondeterministic_adaptive_stepsize(Flowpipe & result, cons
 	}
 
 	// add the uncertainties and the cutoff intervals onto the result
+	double ratio = 0;
+
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
 		tmvTmp.tms[i].remainder += intDifferences[i];
+		ratio = std::max(ratio, Stepsize_Controller::ratio(tmvTmp.tms[i].remainder, x.tms[i].remainder));
 
 		if( ! tmvTmp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 		{
 			bfound = false;
-			break;
 		}
 	}
 
 	for(; !bfound;)
 	{
 		bfound = true;
-		double newStep = tm_setting.step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
+		++stepsizeStats.rejected;
 
-		if(newStep < tm_setting.step_min)
+		double step = tm_setting.step_exp_table[1].sup();
+
+		if(step <= tm_setting.step_min)
 		{
 			return 0;
 		}
 
+		// reduce the time step size as predicted from the remainders of the rejected one
+		double newStep = tm_setting.step_controller.reject(step, ratio, tm_setting.order);
+
+		if(newStep < tm_setting.step_min)
+		{
+			newStep = tm_setting.step_min;
+		}
+
 		tm_setting.setStepsize(newStep, tm_setting.order);
 
 		intermediate_ranges.clear();
 		x.Picard_ctrunc_normal(tmvTmp, new_x0, ode, tm_setting.step_exp_table, rangeDimExt, tm_setting.order, tm_setting.cutoff_threshold, intermediate_ranges, g_setting);
 
 		// recompute the interval evaluation of the polynomial differences
+		ratio = 0;
+
 		for(int i=0; i<rangeDim; ++i)
 		{
 			polyDifferences[i].intEvalNormal(intDifferences[i], tm_setting.step_exp_table);
 
 			tmvTmp.tms[i].remainder += intDifferences[i];
+			ratio = std::max(ratio, Stepsize_Controller::ratio(tmvTmp.tms[i].remainder, x.tms[i].remainder));
 
 			if( ! tmvTmp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 			{
 				bfound = false;
-				break;
 			}
 		}
 	}
 
+	++stepsizeStats.accepted;
+	tm_setting.step_controller.accept(tm_setting.step_exp_table[1].sup(), ratio, tm_setting.order);
+
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
 		x.tms[i].remainder = tmvTmp.tms[i].remainder;
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -1297,25 +1630,12 @@ int Flowpipe::advance_nondeterministic_adaptive_stepsize(Flowpipe & result, cons
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -1417,12 +1737,9 @@ int Flowpipe::advance_deterministic_adaptive_order(Flowpipe & result, const std:
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 	bool bfound = true;
 
@@ -1509,10 +1826,12 @@ int Flowpipe::advance_deterministic_adaptive_order(Flowpipe & result, const std:
 		x.tms[i].remainder = tmvTmp.tms[i].remainder;
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -1521,25 +1840,12 @@ int Flowpipe::advance_deterministic_adaptive_order(Flowpipe & result, const std:
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -1641,12 +1947,9 @@ int Flowpipe::advance_nondeterministic_adaptive_order(Flowpipe & result, const s
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 	bool bfound = true;
 
@@ -1733,10 +2036,12 @@ int Flowpipe::advance_nondeterministic_adaptive_order(Flowpipe & result, const s
 		x.tms[i].remainder = tmvTmp.tms[i].remainder;
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -1745,25 +2050,12 @@ int Flowpipe::advance_nondeterministic_adaptive_order(Flowpipe & result, const s
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -1775,19 +2067,22 @@ int Flowpipe::advance_nondeterministic_adaptive_order(Flowpipe & result, const s
 
 
 
-int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Expression_AST<Real> > & ode, const Taylor_Model_Computation_Setting & tm_setting, const std::vector<Constraint> & invariant, const Global_Computation_Setting & g_setting, Symbolic_Remainder & symbolic_remainder) const
+// The same with symbolic remainders.
+template <class DATA_TYPE>
+static int deterministic_step(TaylorModelVec<DATA_TYPE> & resultPre, TaylorModelVec<DATA_TYPE> & resultTmv, const TaylorModelVec<DATA_TYPE> & tmvPre, const TaylorModelVec<DATA_TYPE> & tmv, const std::vector<Interval> & domain, const std::vector<Expression_AST<Real> > & ode, const Taylor_Model_Computation_Setting & tm_setting, const std::vector<Constraint> & invariant, const Global_Computation_Setting & g_setting, Symbolic_Remainder & symbolic_remainder)
 {
 	unsigned int rangeDim = ode.size();
 	unsigned int rangeDimExt = rangeDim + 1;
 	Interval intUnit(-1,1);
-	result.clear();
+	std::vector<Matrix<DATA_TYPE> > & Phi_L = symbolic_remainder.linear_maps<DATA_TYPE>();
+	std::vector<Interval> errors;
 
 	// evaluate the the initial set x0
-	TaylorModelVec<Real> tmv_of_x0;
+	TaylorModelVec<DATA_TYPE> tmv_of_x0;
 	tmvPre.evaluate_time(tmv_of_x0, tm_setting.step_end_exp_table);
 
 	// the center point of x0's polynomial part
-	std::vector<Real> const_of_x0;
+	std::vector<DATA_TYPE> const_of_x0;
 	tmv_of_x0.constant(const_of_x0);
 
 	for(unsigned int i=0; i<rangeDim; ++i)
@@ -1797,21 +2092,21 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		const_of_x0[i] += c;
 	}
 
-	TaylorModelVec<Real> tmv_c0(const_of_x0, rangeDimExt);
+	TaylorModelVec<DATA_TYPE> tmv_c0(const_of_x0, rangeDimExt);
 
 	// introduce a new variable r0 such that x0 = c0 + A*r0, then r0 is origin-centered
 	tmv_of_x0.rmConstant();
 
 
 	// decompose the linear and nonlinear part
-	TaylorModelVec<Real> x0_linear, x0_other;
+	TaylorModelVec<DATA_TYPE> x0_linear, x0_other;
 	tmv_of_x0.decompose(x0_linear, x0_other);
 
-	Matrix<Real> Phi_L_i(rangeDim, rangeDim);
+	Matrix<DATA_TYPE> Phi_L_i(rangeDim, rangeDim);
 
 	x0_linear.linearCoefficients(Phi_L_i);
 
-	Matrix<Real> local_trans_linear = Phi_L_i;
+	Matrix<DATA_TYPE> local_trans_linear = Phi_L_i;
 
 	Phi_L_i.right_scale_assign(symbolic_remainder.scalars);
 
@@ -1819,16 +2114,16 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 	// compute the remainder part under the linear transformation
 	Matrix<Interval> J_i(rangeDim, 1);
 
-	for(unsigned int i=0; i<symbolic_remainder.Phi_L.size(); ++i)
+	for(unsigned int i=0; i<Phi_L.size(); ++i)
 	{
-		symbolic_remainder.Phi_L[i] = Phi_L_i * symbolic_remainder.Phi_L[i];
+		Phi_L[i] = Phi_L_i * Phi_L[i];
 	}
 
-	symbolic_remainder.Phi_L.push_back(Phi_L_i);
+	Phi_L.push_back(Phi_L_i);
 
-	for(unsigned int i=1; i<symbolic_remainder.Phi_L.size(); ++i)
+	for(unsigned int i=1; i<Phi_L.size(); ++i)
 	{
-		J_i += symbolic_remainder.Phi_L[i] * symbolic_remainder.J[i-1];
+		J_i += Phi_L[i] * symbolic_remainder.J[i-1];
 	}
 
 	Matrix<Interval> J_ip1(rangeDim, 1);
@@ -1839,14 +2134,14 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 	if(symbolic_remainder.J.size() > 0)
 	{
 		// compute the polynomial part under the linear transformation
-		std::vector<Polynomial<Real> > initial_linear = symbolic_remainder.Phi_L[0] * symbolic_remainder.polynomial_of_initial_set;
+		std::vector<Polynomial<DATA_TYPE> > initial_linear = Phi_L[0] * symbolic_remainder.initial_polynomials<DATA_TYPE>();
 
 		// compute the other part
 		std::vector<Interval> tmvPolyRange;
 		tmv.polyRangeNormal(tmvPolyRange, tm_setting.step_end_exp_table);
-		x0_other.insert_ctrunc_normal(result.tmv, tmv, tmvPolyRange, tm_setting.step_end_exp_table, domain.size(), tm_setting.order, tm_setting.cutoff_threshold);
+		x0_other.insert_ctrunc_normal(resultTmv, tmv, tmvPolyRange, tm_setting.step_end_exp_table, domain.size(), tm_setting.order, tm_setting.cutoff_threshold);
 
-		result.tmv.Remainder(J_ip1);
+		resultTmv.Remainder(J_ip1);
 
 		Matrix<Interval> x0_rem(rangeDim, 1);
 		tmv_of_x0.Remainder(x0_rem);
@@ -1854,14 +2149,22 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 
 		for(int i=0; i<rangeDim; ++i)
 		{
-			result.tmv.tms[i].expansion += initial_linear[i];
+			resultTmv.tms[i].expansion += initial_linear[i];
+		}
+
+		// the rounding errors are remainders of this step, so that the later steps map them by Phi_L
+		resultTmv.roundoff_normal(errors, tm_setting.step_end_exp_table);
+
+		for(int i=0; i<rangeDim; ++i)
+		{
+			J_ip1[i][0] += errors[i];
 		}
 
 		// contract J_ip1 and J_i
 		if(invariant.size() > 0)
 		{
 			std::vector<Interval> polyRangeOfx0;
-			result.tmv.polyRangeNormal(polyRangeOfx0, tm_setting.step_end_exp_table);
+			resultTmv.polyRangeNormal(polyRangeOfx0, tm_setting.step_end_exp_table);
 
 			std::vector<Interval> intVecTmp(rangeDim);
 			std::vector<Interval> original_remainders(rangeDim);
@@ -1888,31 +2191,32 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 				double up_diff = original_remainders[i].sup() - contracted_remainders[i].sup();
 				J_ip1[i][0].shrink_up(up_diff);
 
-				result.tmv.tms[i].remainder = contracted_remainders[i];
-				range_of_x0.push_back(polyRangeOfx0[i] + result.tmv.tms[i].remainder);
+				resultTmv.tms[i].remainder = contracted_remainders[i];
+				range_of_x0.push_back(polyRangeOfx0[i] + resultTmv.tms[i].remainder);
 			}
 		}
 		else
 		{
 			for(int i=0; i<rangeDim; ++i)
 			{
-				result.tmv.tms[i].remainder = J_ip1[i][0] + J_i[i][0];
+				resultTmv.tms[i].remainder = J_ip1[i][0] + J_i[i][0];
 			}
 
-			result.tmv.intEvalNormal(range_of_x0, tm_setting.step_end_exp_table);
+			resultTmv.intEvalNormal(range_of_x0, tm_setting.step_end_exp_table);
 		}
 	}
 	else
 	{
 		std::vector<Interval> tmvPolyRange;
 		tmv.polyRangeNormal(tmvPolyRange, tm_setting.step_end_exp_table);
-		tmv_of_x0.insert_ctrunc_normal(result.tmv, tmv, tmvPolyRange, tm_setting.step_end_exp_table, domain.size(), tm_setting.order, tm_setting.cutoff_threshold);
+		tmv_of_x0.insert_ctrunc_normal(resultTmv, tmv, tmvPolyRange, tm_setting.step_end_exp_table, domain.size(), tm_setting.order, tm_setting.cutoff_threshold);
+		resultTmv.roundoff_normal(errors, tm_setting.step_end_exp_table);
 
 		// contract J_ip1
 		if(invariant.size() > 0)
 		{
 			std::vector<Interval> polyRangeOfx0;
-			result.tmv.polyRangeNormal(polyRangeOfx0, tm_setting.step_end_exp_table);
+			resultTmv.polyRangeNormal(polyRangeOfx0, tm_setting.step_end_exp_table);
 
 			std::vector<Interval> intVecTmp(rangeDim);
 			for(int i=0; i<rangeDim; ++i)
@@ -1923,7 +2227,7 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 			std::vector<Interval> contracted_remainders(rangeDim);
 			for(int i=0; i<rangeDim; ++i)
 			{
-				contracted_remainders[i] = result.tmv.tms[i].remainder;
+				contracted_remainders[i] = resultTmv.tms[i].remainder;
 			}
 
 			int res = contract_remainder(intVecTmp, contracted_remainders, invariant);
@@ -1935,23 +2239,20 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 
 			for(int i=0; i<rangeDim; ++i)
 			{
-				result.tmv.tms[i].remainder = contracted_remainders[i];
-				range_of_x0.push_back(polyRangeOfx0[i] + result.tmv.tms[i].remainder);
+				resultTmv.tms[i].remainder = contracted_remainders[i];
+				range_of_x0.push_back(polyRangeOfx0[i] + resultTmv.tms[i].remainder);
 			}
 		}
 		else
 		{
-			result.tmv.intEvalNormal(range_of_x0, tm_setting.step_end_exp_table);
+			resultTmv.intEvalNormal(range_of_x0, tm_setting.step_end_exp_table);
 		}
 
-		result.tmv.Remainder(J_ip1);
+		resultTmv.Remainder(J_ip1);
 	}
 
-	symbolic_remainder.J.push_back(J_ip1);
-
-
 	// Compute the scaling matrix S.
-	std::vector<Real> S, invS;
+	std::vector<DATA_TYPE> S, invS;
 
 	for(int i=0; i<rangeDim; ++i)
 	{
@@ -1966,25 +2267,35 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		}
 		else
 		{
-			S.push_back(sup);
-			Real tmp = 1/sup;
-			invS.push_back(tmp);
-			symbolic_remainder.scalars[i] = tmp;
+			DATA_TYPE s, s_inv;
+			symbolic_remainder.scalars[i] = scaling_factors(s, s_inv, sup);
+			S.push_back(s);
+			invS.push_back(s_inv);
 			range_of_x0[i] = intUnit;
 		}
 	}
 
-	result.tmv.scale_assign(invS);
+	resultTmv.scale_assign(invS);
 
-	TaylorModelVec<Real> new_x0(S);
-	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
+	// the rounding errors of the scaling, J_ip1 holds them unscaled
+	resultTmv.roundoff_normal(errors, tm_setting.step_end_exp_table);
 
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
+	for(int i=0; i<rangeDim; ++i)
 	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
+		J_ip1[i][0] += errors[i] * S[i];
 	}
 
+	symbolic_remainder.J.push_back(J_ip1);
+
+	TaylorModelVec<DATA_TYPE> new_x0(S);
+	new_x0 += tmv_c0;
+	TaylorModelVec<DATA_TYPE> x;
+	Incremental_Picard<DATA_TYPE> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
+
+	// the candidate is given by the values of its coefficients, their errors go with the remainders reset below
+	x.roundoff_normal(errors, tm_setting.step_exp_table);
+
 	bool bfound = true;
 
 	for(unsigned int i=0; i<rangeDim; ++i)
@@ -1992,7 +2303,7 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		x.tms[i].remainder = tm_setting.remainder_estimation[i];
 	}
 
-	TaylorModelVec<Real> tmvTmp;
+	TaylorModelVec<DATA_TYPE> tmvTmp;
 	std::list<Interval> intermediate_ranges;
 
 	x.Picard_ctrunc_normal(tmvTmp, new_x0, ode, tm_setting.step_exp_table, rangeDimExt, tm_setting.order, tm_setting.cutoff_threshold, intermediate_ranges, g_setting);
@@ -2001,7 +2312,7 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 	std::vector<Interval> intDifferences;
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
-		Polynomial<Real> polyTmp;
+		Polynomial<DATA_TYPE> polyTmp;
 		polyTmp = tmvTmp.tms[i].expansion - x.tms[i].expansion;
 
 		Interval I;
@@ -2034,10 +2345,12 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		}
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -2046,31 +2359,47 @@ int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Express
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
-	result.domain = domain;
-	result.domain[0] = tm_setting.step_exp_table[1];
+	resultPre = std::move(x);
 
 	return 1;
 }
 
+int Flowpipe::advance_deterministic(Flowpipe & result, const std::vector<Expression_AST<Real> > & ode, const Taylor_Model_Computation_Setting & tm_setting, const std::vector<Constraint> & invariant, const Global_Computation_Setting & g_setting, Symbolic_Remainder & symbolic_remainder) const
+{
+	result.clear();
+
+	int res;
+
+	if(roundingErrorSweep)
+	{
+		TaylorModelVec<Float> floatPre, floatTmv, resultPre, resultTmv;
+		tmvPre.toFloat(floatPre);
+		tmv.toFloat(floatTmv);
+
+		res = deterministic_step(resultPre, resultTmv, floatPre, floatTmv, domain, ode, tm_setting, invariant, g_setting, symbolic_remainder);
+
+		resultPre.toReal(result.tmvPre);
+		resultTmv.toReal(result.tmv);
+	}
+	else
+	{
+		res = deterministic_step(result.tmvPre, result.tmv, tmvPre, tmv, domain, ode, tm_setting, invariant, g_setting, symbolic_remainder);
+	}
+
+	if(res == 1)
+	{
+		result.domain = domain;
+		result.domain[0] = tm_setting.step_exp_table[1];
+	}
+
+	return res;
+}
+
 int Flowpipe::advance_nondeterministic(Flowpipe & result, const std::vector<Expression_AST<Interval> > & ode, const Taylor_Model_Computation_Setting & tm_setting, const std::vector<Constraint> & invariant, const Global_Computation_Setting & g_setting, Symbolic_Remainder & symbolic_remainder) const
 {
 	unsigned int rangeDim = ode.size();
@@ -2274,12 +2603,9 @@ int Flowpipe::advance_nondeterministic(Flowpipe & result, const std::vector<Expr
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 	bool bfound = true;
 
@@ -2330,10 +2656,12 @@ int Flowpipe::advance_nondeterministic(Flowpipe & result, const std::vector<Expr
 		}
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -2342,25 +2670,12 @@ int Flowpipe::advance_nondeterministic(Flowpipe & result, const std::vector<Expr
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -2570,12 +2885,9 @@ int Flowpipe::advance_deterministic_adaptive_stepsize(Flowpipe & result, const s
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 	bool bfound = true;
 
@@ -2605,56 +2917,75 @@ int Flowpipe::advance_deterministic_adaptive_stepsize(Flowpipe & result, const s
 	}
 
 	// add the uncertainties and the cutoff intervals onto the result
+	double ratio = 0;
+
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
 		tmvTmp.tms[i].remainder += intDifferences[i];
+		ratio = std::max(ratio, Stepsize_Controller::ratio(tmvTmp.tms[i].remainder, x.tms[i].remainder));
 
 		if( ! tmvTmp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 		{
 			bfound = false;
-			break;
 		}
 	}
 
 	for(; !bfound;)
 	{
 		bfound = true;
-		double newStep = tm_setting.step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
+		++stepsizeStats.rejected;
 
-		if(newStep < tm_setting.step_min)
+		double step = tm_setting.step_exp_table[1].sup();
+
+		if(step <= tm_setting.step_min)
 		{
 			return 0;
 		}
 
+		// reduce the time step size as predicted from the remainders of the rejected one
+		double newStep = tm_setting.step_controller.reject(step, ratio, tm_setting.order);
+
+		if(newStep < tm_setting.step_min)
+		{
+			newStep = tm_setting.step_min;
+		}
+
 		tm_setting.setStepsize(newStep, tm_setting.order);
 
 		intermediate_ranges.clear();
 		x.Picard_ctrunc_normal(tmvTmp, new_x0, ode, tm_setting.step_exp_table, rangeDimExt, tm_setting.order, tm_setting.cutoff_threshold, intermediate_ranges, g_setting);
 
 		// recompute the interval evaluation of the polynomial differences
+		ratio = 0;
+
 		for(int i=0; i<rangeDim; ++i)
 		{
 			polyDifferences[i].intEvalNormal(intDifferences[i], tm_setting.step_exp_table);
 
 			tmvTmp.tms[i].remainder += intDifferences[i];
+			ratio = std::max(ratio, Stepsize_Controller::ratio(tmvTmp.tms[i].remainder, x.tms[i].remainder));
 
 			if( ! tmvTmp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 			{
 				bfound = false;
-				break;
 			}
 		}
 	}
 
+	++stepsizeStats.accepted;
+	tm_setting.step_controller.accept(tm_setting.step_exp_table[1].sup(), ratio, tm_setting.order);
+
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
 		x.tms[i].remainder = tmvTmp.tms[i].remainder;
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -2663,25 +2994,12 @@ int Flowpipe::advance_deterministic_adaptive_stepsize(Flowpipe & result, const s
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -2891,12 +3209,9 @@ int Flowpipe::advance_nondeterministic_adaptive_stepsize(Flowpipe & result, cons
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 	bool bfound = true;
 
@@ -2926,56 +3241,75 @@ int Flowpipe::advance_nondeterministic_adaptive_stepsize(Flowpipe & result, cons
 	}
 
 	// add the uncertainties and the cutoff intervals onto the result
+	double ratio = 0;
+
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
 		tmvTmp.tms[i].remainder += intDifferences[i];
+		ratio = std::max(ratio, Stepsize_Controller::ratio(tmvTmp.tms[i].remainder, x.tms[i].remainder));
 
 		if( ! tmvTmp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 		{
 			bfound = false;
-			break;
 		}
 	}
 
 	for(; !bfound;)
 	{
 		bfound = true;
-		double newStep = tm_setting.step_exp_table[1].sup() * LAMBDA_DOWN;	// reduce the time step size
+		++stepsizeStats.rejected;
 
-		if(newStep < tm_setting.step_min)
+		double step = tm_setting.step_exp_table[1].sup();
+
+		if(step <= tm_setting.step_min)
 		{
 			return 0;
 		}
 
+		// reduce the time step size as predicted from the remainders of the rejected one
+		double newStep = tm_setting.step_controller.reject(step, ratio, tm_setting.order);
+
+		if(newStep < tm_setting.step_min)
+		{
+			newStep = tm_setting.step_min;
+		}
+
 		tm_setting.setStepsize(newStep, tm_setting.order);
 
 		intermediate_ranges.clear();
 		x.Picard_ctrunc_normal(tmvTmp, new_x0, ode, tm_setting.step_exp_table, rangeDimExt, tm_setting.order, tm_setting.cutoff_threshold, intermediate_ranges, g_setting);
 
 		// recompute the interval evaluation of the polynomial differences
+		ratio = 0;
+
 		for(int i=0; i<rangeDim; ++i)
 		{
 			polyDifferences[i].intEvalNormal(intDifferences[i], tm_setting.step_exp_table);
 
 			tmvTmp.tms[i].remainder += intDifferences[i];
+			ratio = std::max(ratio, Stepsize_Controller::ratio(tmvTmp.tms[i].remainder, x.tms[i].remainder));
 
 			if( ! tmvTmp.tms[i].remainder.subseteq(x.tms[i].remainder) )
 			{
 				bfound = false;
-				break;
 			}
 		}
 	}
 
+	++stepsizeStats.accepted;
+	tm_setting.step_controller.accept(tm_setting.step_exp_table[1].sup(), ratio, tm_setting.order);
+
 	for(unsigned int i=0; i<rangeDim; ++i)
 	{
 		x.tms[i].remainder = tmvTmp.tms[i].remainder;
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -2984,25 +3318,12 @@ int Flowpipe::advance_nondeterministic_adaptive_stepsize(Flowpipe & result, cons
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -3212,12 +3533,9 @@ int Flowpipe::advance_deterministic_adaptive_order(Flowpipe & result, const std:
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 	bool bfound = true;
 
@@ -3303,10 +3621,12 @@ int Flowpipe::advance_deterministic_adaptive_order(Flowpipe & result, const std:
 		x.tms[i].remainder = tmvTmp.tms[i].remainder;
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
@@ -3315,25 +3635,12 @@ int Flowpipe::advance_deterministic_adaptive_order(Flowpipe & result, const std:
 		for(unsigned int i=0; i<rangeDim; ++i)
 		{
 			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -3543,12 +3850,9 @@ int Flowpipe::advance_nondeterministic_adaptive_order(Flowpipe & result, const s
 
 	TaylorModelVec<Real> new_x0(S);
 	new_x0 += tmv_c0;
-	TaylorModelVec<Real> x = new_x0;
-
-	for(unsigned int i=1; i<=tm_setting.order; ++i)
-	{
-		x.Picard_no_remainder_assign(new_x0, ode, rangeDimExt, i, tm_setting.cutoff_threshold);
-	}
+	TaylorModelVec<Real> x;
+	Incremental_Picard<Real> picard(ode, rangeDimExt);
+	picard.iterate(x, new_x0, ode, tm_setting.order, tm_setting.cutoff_threshold);
 
 	bool bfound = true;
 
@@ -3634,37 +3938,26 @@ int Flowpipe::advance_nondeterministic_adaptive_order(Flowpipe & result, const s
 		x.tms[i].remainder = tmvTmp.tms[i].remainder;
 	}
 
+	Remainder_Refinement refinement(tm_setting, rangeDim);
+
 	bool bfinished = false;
 	for(int rSteps = 0; !bfinished && (rSteps <= MAX_REFINEMENT_STEPS); ++rSteps)
 	{
-		bfinished = true;
+		refinement.next();
 
 		std::vector<Interval> newRemainders;
 		x.Picard_ctrunc_normal_remainder(newRemainders, ode, tm_setting.step_exp_table[1], tm_setting.order, intermediate_ranges, g_setting);
 
 		// add the uncertainties and the cutoff intervals onto the result
-		for(unsigned int i=0; i<rangeDim; ++i)
-		{
-			newRemainders[i] += intDifferences[i];
-
-			if(newRemainders[i].subseteq(x.tms[i].remainder))
-			{
-				if(x.tms[i].remainder.widthRatio(newRemainders[i]) <= STOP_RATIO)
-				{
-					bfinished = false;
-				}
-
-				x.tms[i].remainder = newRemainders[i];
-			}
-			else
-			{
-				bfinished = true;
-				break;
-			}
+		for(unsigned int i=0; i<rangeDim; ++i)
+		{
+			newRemainders[i] += intDifferences[i];
 		}
+
+		bfinished = !refinement.update(x, newRemainders);
 	}
 
-	result.tmvPre = x;
+	result.tmvPre = std::move(x);
 	result.domain = domain;
 	result.domain[0] = tm_setting.step_exp_table[1];
 
@@ -3887,7 +4180,7 @@ void LinearFlowpipe::evaluate(TaylorModelVec<Real> & result, const TaylorModelVe
 			tmTmp1 += tmTmp2;
 		}
 
-		tmvTmp.tms.push_back(tmTmp1);
+		tmvTmp.tms.push_back(std::move(tmTmp1));
 	}
 
 	tmvTmp.insert_ctrunc(result, tmv_of_X0, polyRangeX0, domain, tm_setting.order, tm_setting.cutoff_threshold);
@@ -3935,7 +4228,7 @@ void LinearFlowpipe::evaluate(TaylorModelVec<Real> & result, const std::vector<u
 			tmTmp1 += tmTmp2;
 		}
 
-		tmvTmp.tms.push_back(tmTmp1);
+		tmvTmp.tms.push_back(std::move(tmTmp1));
 	}
 
 	tmvTmp.insert_ctrunc(result, tmv_of_X0, polyRangeX0, domain, tm_setting.order, tm_setting.cutoff_threshold);
@@ -4000,6 +4293,15 @@ Result_of_Reachability::Result_of_Reachability(const Result_of_Reachability & re
 	safety_of_flowpipes	= result.safety_of_flowpipes;
 }
 
+Result_of_Reachability::Result_of_Reachability(Result_of_Reachability && result) noexcept : fp_end_of_time(std::move(result.fp_end_of_time))
+{
+	status				= result.status;
+	num_of_flowpipes	= result.num_of_flowpipes;
+	nonlinear_flowpipes.swap(result.nonlinear_flowpipes);
+	orders_of_flowpipes.swap(result.orders_of_flowpipes);
+	safety_of_flowpipes.swap(result.safety_of_flowpipes);
+}
+
 Result_of_Reachability::~Result_of_Reachability()
 {
 }
@@ -4029,11 +4331,8 @@ void Result_of_Reachability::transformToTaylorModels(const Taylor_Model_Computat
 
 	for(; fpIter != nonlinear_flowpipes.end(); ++fpIter, ++orderIter)
 	{
-		TaylorModelVec<Real> tmvTmp;
-
-		fpIter->compose(tmvTmp, *orderIter, tm_setting.cutoff_threshold);
-
-		tmv_flowpipes.push_back(tmvTmp);
+		tmv_flowpipes.emplace_back();
+		fpIter->compose(tmv_flowpipes.back(), *orderIter, tm_setting.cutoff_threshold);
 
 		if(bPrint)
 		{
@@ -4071,6 +4370,18 @@ Result_of_Reachability & Result_of_Reachability::operator = (const Result_of_Rea
 	return *this;
 }
 
+Result_of_Reachability & Result_of_Reachability::operator = (Result_of_Reachability && result) noexcept
+{
+	status				= result.status;
+	num_of_flowpipes	= result.num_of_flowpipes;
+	fp_end_of_time		= std::move(result.fp_end_of_time);
+	nonlinear_flowpipes.swap(result.nonlinear_flowpipes);
+	orders_of_flowpipes.swap(result.orders_of_flowpipes);
+	safety_of_flowpipes.swap(result.safety_of_flowpipes);
+
+	return *this;
+}
+
 
 
 
@@ -4895,7 +5206,7 @@ int Deterministic_Continuous_Dynamics::reach(std::list<Flowpipe> & flowpipes, st
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				t += step;
 
@@ -4943,6 +5254,7 @@ int Deterministic_Continuous_Dynamics::reach_adaptive_stepsize(std::list<Flowpip
 	for(int m=0; m<initialSets.size(); ++m)
 	{
 		Flowpipe newFlowpipe, currentFlowpipe = initialSets[m];
+		tm_setting.step_controller.reset();
 
 		for(double t=THRESHOLD_HIGH; t < time;)
 		{
@@ -4981,7 +5293,7 @@ int Deterministic_Continuous_Dynamics::reach_adaptive_stepsize(std::list<Flowpip
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				double current_stepsize = tm_setting.step_exp_table[1].sup();
 				t += current_stepsize;
@@ -4993,15 +5305,30 @@ int Deterministic_Continuous_Dynamics::reach_adaptive_stepsize(std::list<Flowpip
 					printf("order = %d\n", tm_setting.order);
 				}
 
-				double new_stepsize = current_stepsize * LAMBDA_UP;
+				double new_stepsize = tm_setting.step_controller.next(current_stepsize);
 				double last_step = time - t;
 
-				if(new_stepsize > last_step)
+				if(new_stepsize > tm_setting.step_max)
+				{
+					new_stepsize = tm_setting.step_max;
+				}
+				else if(new_stepsize < tm_setting.step_min)
+				{
+					new_stepsize = tm_setting.step_min;
+				}
+
+				// the last step ends at the time horizon, so that no sliver of it is left for one more step
+				if(new_stepsize > last_step - THRESHOLD_HIGH)
+				{
+					new_stepsize = last_step + THRESHOLD_HIGH;
+				}
+				else if(2 * new_stepsize > last_step)
 				{
-					new_stepsize = last_step + THRESHOLD_LOW;
+					// two equal steps instead of a full and a short one
+					new_stepsize = last_step / 2;
 				}
 
-				if(new_stepsize <= tm_setting.step_max - THRESHOLD_LOW)
+				if(new_stepsize != current_stepsize)
 				{
 					tm_setting.setStepsize(new_stepsize, tm_setting.order);
 				}
@@ -5081,7 +5408,7 @@ int Deterministic_Continuous_Dynamics::reach_adaptive_order(std::list<Flowpipe>
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				t += step;
 
@@ -5176,7 +5503,7 @@ int Deterministic_Continuous_Dynamics::reach_symbolic_remainder(std::list<Flowpi
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				t += step;
 
@@ -5233,6 +5560,7 @@ int Deterministic_Continuous_Dynamics::reach_symbolic_remainder_adaptive_stepsiz
 		Flowpipe newFlowpipe, currentFlowpipe = initialSets[m];
 
 		tm_setting.setStepsize(tm_setting.step_max, tm_setting.order);
+		tm_setting.step_controller.reset();
 
 		Symbolic_Remainder symbolic_remainder(currentFlowpipe);
 
@@ -5273,7 +5601,7 @@ int Deterministic_Continuous_Dynamics::reach_symbolic_remainder_adaptive_stepsiz
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				if(symbolic_remainder.J.size() >= tm_setting.queue_size)
 				{
@@ -5290,15 +5618,30 @@ int Deterministic_Continuous_Dynamics::reach_symbolic_remainder_adaptive_stepsiz
 					printf("order = %d\n", tm_setting.order);
 				}
 
-				double new_stepsize = current_stepsize * LAMBDA_UP;
+				double new_stepsize = tm_setting.step_controller.next(current_stepsize);
 				double last_step = time - t;
 
-				if(new_stepsize > last_step)
+				if(new_stepsize > tm_setting.step_max)
+				{
+					new_stepsize = tm_setting.step_max;
+				}
+				else if(new_stepsize < tm_setting.step_min)
+				{
+					new_stepsize = tm_setting.step_min;
+				}
+
+				// the last step ends at the time horizon, so that no sliver of it is left for one more step
+				if(new_stepsize > last_step - THRESHOLD_HIGH)
+				{
+					new_stepsize = last_step + THRESHOLD_HIGH;
+				}
+				else if(2 * new_stepsize > last_step)
 				{
-					new_stepsize = last_step + THRESHOLD_LOW;
+					// two equal steps instead of a full and a short one
+					new_stepsize = last_step / 2;
 				}
 
-				if(new_stepsize <= tm_setting.step_max - THRESHOLD_LOW)
+				if(new_stepsize != current_stepsize)
 				{
 					tm_setting.setStepsize(new_stepsize, tm_setting.order);
 				}
@@ -5382,7 +5725,7 @@ int Deterministic_Continuous_Dynamics::reach_symbolic_remainder_adaptive_order(s
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				t += step;
 
@@ -5533,10 +5876,184 @@ void Deterministic_Continuous_Dynamics::reach(Result_of_Reachability & result, C
 		}
 	}
 
-	Flowpipe fpTmp = result.nonlinear_flowpipes.back();
-	result.fp_end_of_time = fpTmp;
+	const Flowpipe & fpLast = result.nonlinear_flowpipes.back();
+	result.fp_end_of_time.tmv = fpLast.tmv;
+	result.fp_end_of_time.domain = fpLast.domain;
+
+	fpLast.tmvPre.evaluate_time(result.fp_end_of_time.tmvPre, setting.tm_setting.step_end_exp_table);
+}
+
+int Deterministic_Continuous_Dynamics::reach_end_of_time(Flowpipe & fp_end_of_time, unsigned long & num_of_flowpipes, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const
+{
+	Taylor_Model_Computation_Setting & tm_setting = setting.tm_setting;
+	const Global_Computation_Setting & g_setting = setting.g_setting;
+	std::vector<Constraint> dummy_invariant;
+
+	bool bSymbolicRemainder = tm_setting.queue_size > 0;
+	bool bAdaptiveStepsize = tm_setting.step_min > 0;
+	bool bAdaptiveOrder = !bAdaptiveStepsize && tm_setting.order_max > 0;
+
+	int checking_result = COMPLETED_SAFE;
+
+	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
+	bool bAdvanced = false;
+
+	Symbolic_Remainder symbolic_remainder;
+
+	if(bAdaptiveStepsize)
+	{
+		// start from the largest step size, so that the result does not depend on the runs before
+		tm_setting.setStepsize(tm_setting.step_max, tm_setting.order);
+		tm_setting.step_controller.reset();
+	}
+
+	if(bSymbolicRemainder)
+	{
+		symbolic_remainder.reset(currentFlowpipe);
+	}
+
+	for(double t=THRESHOLD_HIGH; t < setting.time;)
+	{
+		int res;
+
+		if(bSymbolicRemainder)
+		{
+			if(bAdaptiveStepsize)
+			{
+				res = currentFlowpipe.advance_deterministic_adaptive_stepsize(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting, symbolic_remainder);
+			}
+			else if(bAdaptiveOrder)
+			{
+				res = currentFlowpipe.advance_deterministic_adaptive_order(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting, symbolic_remainder);
+			}
+			else
+			{
+				res = currentFlowpipe.advance_deterministic(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting, symbolic_remainder);
+			}
+		}
+		else
+		{
+			if(bAdaptiveStepsize)
+			{
+				res = currentFlowpipe.advance_deterministic_adaptive_stepsize(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting);
+			}
+			else if(bAdaptiveOrder)
+			{
+				res = currentFlowpipe.advance_deterministic_adaptive_order(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting);
+			}
+			else
+			{
+				res = currentFlowpipe.advance_deterministic(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting);
+			}
+		}
+
+		if(res != 1)
+		{
+			switch(checking_result)
+			{
+			case COMPLETED_SAFE:
+				checking_result = UNCOMPLETED_SAFE;
+				break;
+			case COMPLETED_UNSAFE:
+				checking_result = UNCOMPLETED_UNSAFE;
+				break;
+			case COMPLETED_UNKNOWN:
+				checking_result = UNCOMPLETED_UNKNOWN;
+				break;
+			}
+
+			break;
+		}
+
+		++num_of_flowpipes;
+		bAdvanced = true;
+
+		// only the latest flowpipe is kept
+		std::swap(currentFlowpipe, newFlowpipe);
+
+		if(unsafeSet.size() > 0)
+		{
+			int safety = currentFlowpipe.safetyChecking(unsafeSet, tm_setting, g_setting);
+
+			if(safety == UNSAFE)
+			{
+				checking_result = COMPLETED_UNSAFE;
+				break;
+			}
+			else if(safety == UNKNOWN && checking_result == COMPLETED_SAFE)
+			{
+				checking_result = COMPLETED_UNKNOWN;
+			}
+		}
+
+		if(bSymbolicRemainder && symbolic_remainder.J.size() >= tm_setting.queue_size)
+		{
+			symbolic_remainder.reset(currentFlowpipe);
+		}
+
+		double current_stepsize = tm_setting.step_exp_table[1].sup();
+		t += current_stepsize;
+
+		if(setting.bPrint)
+		{
+			printf("time = %f,\t", t);
+			printf("step = %f,\t", current_stepsize);
+			printf("order = %d\n", tm_setting.order);
+		}
+
+		if(bAdaptiveStepsize)
+		{
+			double new_stepsize = tm_setting.step_controller.next(current_stepsize);
+			double last_step = setting.time - t;
+
+			if(new_stepsize > tm_setting.step_max)
+			{
+				new_stepsize = tm_setting.step_max;
+			}
+			else if(new_stepsize < tm_setting.step_min)
+			{
+				new_stepsize = tm_setting.step_min;
+			}
+
+			// the last step ends at the time horizon, so that no sliver of it is left for one more step
+			if(new_stepsize > last_step - THRESHOLD_HIGH)
+			{
+				new_stepsize = last_step + THRESHOLD_HIGH;
+			}
+			else if(2 * new_stepsize > last_step)
+			{
+				// two equal steps instead of a full and a short one
+				new_stepsize = last_step / 2;
+			}
+
+			if(new_stepsize != current_stepsize)
+			{
+				tm_setting.setStepsize(new_stepsize, tm_setting.order);
+			}
+		}
+		else if(bAdaptiveOrder && tm_setting.order > tm_setting.order_min)
+		{
+			--tm_setting.order;
+		}
+	}
+
+	fp_end_of_time.clear();
+
+	if(bAdvanced)
+	{
+		// the same evaluation at the end of the last step as in reach
+		currentFlowpipe.tmvPre.evaluate_time(fp_end_of_time.tmvPre, tm_setting.step_end_exp_table);
+		fp_end_of_time.tmv = std::move(currentFlowpipe.tmv);
+		fp_end_of_time.domain = std::move(currentFlowpipe.domain);
+	}
+
+	return checking_result;
+}
 
-	fpTmp.tmvPre.evaluate_time(result.fp_end_of_time.tmvPre, setting.tm_setting.step_end_exp_table);
+void Deterministic_Continuous_Dynamics::reach_end_of_time(Result_of_Reachability & result, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const
+{
+	result.clear();
+	result.status = reach_end_of_time(result.fp_end_of_time, result.num_of_flowpipes, setting, initialSet, unsafeSet);
 }
 
 
@@ -5644,7 +6161,7 @@ int Nondeterministic_Continuous_Dynamics::reach(std::list<Flowpipe> & flowpipes,
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				t += step;
 
@@ -5692,6 +6209,7 @@ int Nondeterministic_Continuous_Dynamics::reach_adaptive_stepsize(std::list<Flow
 	for(int m=0; m<initialSets.size(); ++m)
 	{
 		Flowpipe newFlowpipe, currentFlowpipe = initialSets[m];
+		tm_setting.step_controller.reset();
 
 		for(double t=THRESHOLD_HIGH; t < time;)
 		{
@@ -5730,7 +6248,7 @@ int Nondeterministic_Continuous_Dynamics::reach_adaptive_stepsize(std::list<Flow
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				double current_stepsize = tm_setting.step_exp_table[1].sup();
 				t += current_stepsize;
@@ -5742,15 +6260,30 @@ int Nondeterministic_Continuous_Dynamics::reach_adaptive_stepsize(std::list<Flow
 					printf("order = %d\n", tm_setting.order);
 				}
 
-				double new_stepsize = current_stepsize * LAMBDA_UP;
+				double new_stepsize = tm_setting.step_controller.next(current_stepsize);
 				double last_step = time - t;
 
-				if(new_stepsize > last_step)
+				if(new_stepsize > tm_setting.step_max)
+				{
+					new_stepsize = tm_setting.step_max;
+				}
+				else if(new_stepsize < tm_setting.step_min)
+				{
+					new_stepsize = tm_setting.step_min;
+				}
+
+				// the last step ends at the time horizon, so that no sliver of it is left for one more step
+				if(new_stepsize > last_step - THRESHOLD_HIGH)
+				{
+					new_stepsize = last_step + THRESHOLD_HIGH;
+				}
+				else if(2 * new_stepsize > last_step)
 				{
-					new_stepsize = last_step + THRESHOLD_LOW;
+					// two equal steps instead of a full and a short one
+					new_stepsize = last_step / 2;
 				}
 
-				if(new_stepsize <= tm_setting.step_max - THRESHOLD_LOW)
+				if(new_stepsize != current_stepsize)
 				{
 					tm_setting.setStepsize(new_stepsize, tm_setting.order);
 				}
@@ -5830,7 +6363,7 @@ int Nondeterministic_Continuous_Dynamics::reach_adaptive_order(std::list<Flowpip
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				t += step;
 
@@ -5925,7 +6458,7 @@ int Nondeterministic_Continuous_Dynamics::reach_symbolic_remainder(std::list<Flo
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				t += step;
 
@@ -5980,6 +6513,7 @@ int Nondeterministic_Continuous_Dynamics::reach_symbolic_remainder_adaptive_step
 	for(int m=0; m<initialSets.size(); ++m)
 	{
 		Flowpipe newFlowpipe, currentFlowpipe = initialSets[m];
+		tm_setting.step_controller.reset();
 
 		Symbolic_Remainder symbolic_remainder(currentFlowpipe);
 
@@ -6020,7 +6554,7 @@ int Nondeterministic_Continuous_Dynamics::reach_symbolic_remainder_adaptive_step
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				if(symbolic_remainder.J.size() >= tm_setting.queue_size)
 				{
@@ -6037,15 +6571,30 @@ int Nondeterministic_Continuous_Dynamics::reach_symbolic_remainder_adaptive_step
 					printf("order = %d\n", tm_setting.order);
 				}
 
-				double new_stepsize = current_stepsize * LAMBDA_UP;
+				double new_stepsize = tm_setting.step_controller.next(current_stepsize);
 				double last_step = time - t;
 
-				if(new_stepsize > last_step)
+				if(new_stepsize > tm_setting.step_max)
+				{
+					new_stepsize = tm_setting.step_max;
+				}
+				else if(new_stepsize < tm_setting.step_min)
+				{
+					new_stepsize = tm_setting.step_min;
+				}
+
+				// the last step ends at the time horizon, so that no sliver of it is left for one more step
+				if(new_stepsize > last_step - THRESHOLD_HIGH)
+				{
+					new_stepsize = last_step + THRESHOLD_HIGH;
+				}
+				else if(2 * new_stepsize > last_step)
 				{
-					new_stepsize = last_step + THRESHOLD_LOW;
+					// two equal steps instead of a full and a short one
+					new_stepsize = last_step / 2;
 				}
 
-				if(new_stepsize <= tm_setting.step_max - THRESHOLD_LOW)
+				if(new_stepsize != current_stepsize)
 				{
 					tm_setting.setStepsize(new_stepsize, tm_setting.order);
 				}
@@ -6129,7 +6678,7 @@ int Nondeterministic_Continuous_Dynamics::reach_symbolic_remainder_adaptive_orde
 					}
 				}
 
-				currentFlowpipe = newFlowpipe;
+				std::swap(currentFlowpipe, newFlowpipe);
 
 				t += step;
 
@@ -6280,10 +6829,184 @@ void Nondeterministic_Continuous_Dynamics::reach(Result_of_Reachability & result
 		}
 	}
 
-	Flowpipe fpTmp = result.nonlinear_flowpipes.back();
-	result.fp_end_of_time = fpTmp;
+	const Flowpipe & fpLast = result.nonlinear_flowpipes.back();
+	result.fp_end_of_time.tmv = fpLast.tmv;
+	result.fp_end_of_time.domain = fpLast.domain;
+
+	fpLast.tmvPre.evaluate_time(result.fp_end_of_time.tmvPre, setting.tm_setting.step_end_exp_table);
+}
+
+int Nondeterministic_Continuous_Dynamics::reach_end_of_time(Flowpipe & fp_end_of_time, unsigned long & num_of_flowpipes, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const
+{
+	Taylor_Model_Computation_Setting & tm_setting = setting.tm_setting;
+	const Global_Computation_Setting & g_setting = setting.g_setting;
+	std::vector<Constraint> dummy_invariant;
+
+	bool bSymbolicRemainder = tm_setting.queue_size > 0;
+	bool bAdaptiveStepsize = tm_setting.step_min > 0;
+	bool bAdaptiveOrder = !bAdaptiveStepsize && tm_setting.order_max > 0;
+
+	int checking_result = COMPLETED_SAFE;
+
+	Flowpipe newFlowpipe, currentFlowpipe = initialSet;
+	bool bAdvanced = false;
+
+	Symbolic_Remainder symbolic_remainder;
+
+	if(bAdaptiveStepsize)
+	{
+		// start from the largest step size, so that the result does not depend on the runs before
+		tm_setting.setStepsize(tm_setting.step_max, tm_setting.order);
+		tm_setting.step_controller.reset();
+	}
+
+	if(bSymbolicRemainder)
+	{
+		symbolic_remainder.reset(currentFlowpipe);
+	}
+
+	for(double t=THRESHOLD_HIGH; t < setting.time;)
+	{
+		int res;
+
+		if(bSymbolicRemainder)
+		{
+			if(bAdaptiveStepsize)
+			{
+				res = currentFlowpipe.advance_nondeterministic_adaptive_stepsize(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting, symbolic_remainder);
+			}
+			else if(bAdaptiveOrder)
+			{
+				res = currentFlowpipe.advance_nondeterministic_adaptive_order(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting, symbolic_remainder);
+			}
+			else
+			{
+				res = currentFlowpipe.advance_nondeterministic(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting, symbolic_remainder);
+			}
+		}
+		else
+		{
+			if(bAdaptiveStepsize)
+			{
+				res = currentFlowpipe.advance_nondeterministic_adaptive_stepsize(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting);
+			}
+			else if(bAdaptiveOrder)
+			{
+				res = currentFlowpipe.advance_nondeterministic_adaptive_order(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting);
+			}
+			else
+			{
+				res = currentFlowpipe.advance_nondeterministic(newFlowpipe, expressions, tm_setting, dummy_invariant, g_setting);
+			}
+		}
+
+		if(res != 1)
+		{
+			switch(checking_result)
+			{
+			case COMPLETED_SAFE:
+				checking_result = UNCOMPLETED_SAFE;
+				break;
+			case COMPLETED_UNSAFE:
+				checking_result = UNCOMPLETED_UNSAFE;
+				break;
+			case COMPLETED_UNKNOWN:
+				checking_result = UNCOMPLETED_UNKNOWN;
+				break;
+			}
+
+			break;
+		}
+
+		++num_of_flowpipes;
+		bAdvanced = true;
+
+		// only the latest flowpipe is kept
+		std::swap(currentFlowpipe, newFlowpipe);
+
+		if(unsafeSet.size() > 0)
+		{
+			int safety = currentFlowpipe.safetyChecking(unsafeSet, tm_setting, g_setting);
+
+			if(safety == UNSAFE)
+			{
+				checking_result = COMPLETED_UNSAFE;
+				break;
+			}
+			else if(safety == UNKNOWN && checking_result == COMPLETED_SAFE)
+			{
+				checking_result = COMPLETED_UNKNOWN;
+			}
+		}
+
+		if(bSymbolicRemainder && symbolic_remainder.J.size() >= tm_setting.queue_size)
+		{
+			symbolic_remainder.reset(currentFlowpipe);
+		}
+
+		double current_stepsize = tm_setting.step_exp_table[1].sup();
+		t += current_stepsize;
+
+		if(setting.bPrint)
+		{
+			printf("time = %f,\t", t);
+			printf("step = %f,\t", current_stepsize);
+			printf("order = %d\n", tm_setting.order);
+		}
+
+		if(bAdaptiveStepsize)
+		{
+			double new_stepsize = tm_setting.step_controller.next(current_stepsize);
+			double last_step = setting.time - t;
+
+			if(new_stepsize > tm_setting.step_max)
+			{
+				new_stepsize = tm_setting.step_max;
+			}
+			else if(new_stepsize < tm_setting.step_min)
+			{
+				new_stepsize = tm_setting.step_min;
+			}
+
+			// the last step ends at the time horizon, so that no sliver of it is left for one more step
+			if(new_stepsize > last_step - THRESHOLD_HIGH)
+			{
+				new_stepsize = last_step + THRESHOLD_HIGH;
+			}
+			else if(2 * new_stepsize > last_step)
+			{
+				// two equal steps instead of a full and a short one
+				new_stepsize = last_step / 2;
+			}
+
+			if(new_stepsize != current_stepsize)
+			{
+				tm_setting.setStepsize(new_stepsize, tm_setting.order);
+			}
+		}
+		else if(bAdaptiveOrder && tm_setting.order > tm_setting.order_min)
+		{
+			--tm_setting.order;
+		}
+	}
+
+	fp_end_of_time.clear();
+
+	if(bAdvanced)
+	{
+		// the same evaluation at the end of the last step as in reach
+		currentFlowpipe.tmvPre.evaluate_time(fp_end_of_time.tmvPre, tm_setting.step_end_exp_table);
+		fp_end_of_time.tmv = std::move(currentFlowpipe.tmv);
+		fp_end_of_time.domain = std::move(currentFlowpipe.domain);
+	}
+
+	return checking_result;
+}
 
-	fpTmp.tmvPre.evaluate_time(result.fp_end_of_time.tmvPre, setting.tm_setting.step_end_exp_table);
+void Nondeterministic_Continuous_Dynamics::reach_end_of_time(Result_of_Reachability & result, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const
+{
+	result.clear();
+	result.status = reach_end_of_time(result.fp_end_of_time, result.num_of_flowpipes, setting, initialSet, unsafeSet);
 }
 
 
@@ -8314,15 +9037,11 @@ void Continuous_Reachability::prepareForPlotting()
 
 			for(iter = linear_flowpipes.begin(); iter != linear_flowpipes.end(); ++iter)
 			{
-				TaylorModelVec<Real> tmvFlowpipe;
-
-				iter->evaluate(tmvFlowpipe, p_p_setting->outputDims, initialSets[m].tmvPre, polyRangeX0, range_of_X0, newDomain, *p_tm_setting);
-
-				result_of_reachability.tmv_flowpipes.push_back(tmvFlowpipe);
+				result_of_reachability.tmv_flowpipes.emplace_back();
+				iter->evaluate(result_of_reachability.tmv_flowpipes.back(), p_p_setting->outputDims, initialSets[m].tmvPre, polyRangeX0, range_of_X0, newDomain, *p_tm_setting);
 
-				Flowpipe flowpipe;
-				flowpipe.domain = newDomain;
-				result_of_reachability.nonlinear_flowpipes.push_back(flowpipe);
+				result_of_reachability.nonlinear_flowpipes.emplace_back();
+				result_of_reachability.nonlinear_flowpipes.back().domain = newDomain;
 
 				if(bPrint)
 				{
@@ -8351,11 +9070,8 @@ void Continuous_Reachability::prepareForPlotting()
 
 		for(; fpIter != result_of_reachability.nonlinear_flowpipes.end(); ++fpIter, ++orderIter)
 		{
-			TaylorModelVec<Real> tmvTmp;
-
-			fpIter->compose(tmvTmp, p_p_setting->outputDims, *orderIter, p_tm_setting->cutoff_threshold);
-
-			result_of_reachability.tmv_flowpipes.push_back(tmvTmp);
+			result_of_reachability.tmv_flowpipes.emplace_back();
+			fpIter->compose(result_of_reachability.tmv_flowpipes.back(), p_p_setting->outputDims, *orderIter, p_tm_setting->cutoff_threshold);
 
 			if(bPrint)
 			{
@@ -8408,15 +9124,11 @@ void Continuous_Reachability::prepareForTMOutput()
 
 			for(iter = linear_flowpipes.begin(); iter != linear_flowpipes.end(); ++iter)
 			{
-				TaylorModelVec<Real> tmvFlowpipe;
-
-				iter->evaluate(tmvFlowpipe, initialSets[m].tmvPre, polyRangeX0, range_of_X0, newDomain, *p_tm_setting);
-
-				result_of_reachability.tmv_flowpipes.push_back(tmvFlowpipe);
+				result_of_reachability.tmv_flowpipes.emplace_back();
+				iter->evaluate(result_of_reachability.tmv_flowpipes.back(), initialSets[m].tmvPre, polyRangeX0, range_of_X0, newDomain, *p_tm_setting);
 
-				Flowpipe flowpipe;
-				flowpipe.domain = newDomain;
-				result_of_reachability.nonlinear_flowpipes.push_back(flowpipe);
+				result_of_reachability.nonlinear_flowpipes.emplace_back();
+				result_of_reachability.nonlinear_flowpipes.back().domain = newDomain;
 
 				if(bPrint)
 				{
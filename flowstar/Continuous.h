@@ -21,17 +21,53 @@ public:
 	std::vector<Real> scalars;
 	std::vector<Polynomial<Real> > polynomial_of_initial_set;
 
+	// the same for the steps with Float coefficients, where Phi_L also bounds the rounding errors of its products
+	std::vector<Matrix<Float> > Phi_L_float;
+	std::vector<Polynomial<Float> > polynomial_of_initial_set_float;
+
 public:
 	Symbolic_Remainder();
 	Symbolic_Remainder(const Flowpipe & initial_set);
 	Symbolic_Remainder(const Symbolic_Remainder & symbolic_remainder);
+	Symbolic_Remainder(Symbolic_Remainder && symbolic_remainder) noexcept;
 	~Symbolic_Remainder();
 
 	void reset(const Flowpipe & initial_set);
 
 	Symbolic_Remainder & operator = (const Symbolic_Remainder & symbolic_remainder);
+	Symbolic_Remainder & operator = (Symbolic_Remainder && symbolic_remainder) noexcept;
+
+	template <class DATA_TYPE>
+	std::vector<Matrix<DATA_TYPE> > & linear_maps();
+
+	template <class DATA_TYPE>
+	std::vector<Polynomial<DATA_TYPE> > & initial_polynomials();
 };
 
+template <>
+inline std::vector<Matrix<Real> > & Symbolic_Remainder::linear_maps<Real>()
+{
+	return Phi_L;
+}
+
+template <>
+inline std::vector<Matrix<Float> > & Symbolic_Remainder::linear_maps<Float>()
+{
+	return Phi_L_float;
+}
+
+template <>
+inline std::vector<Polynomial<Real> > & Symbolic_Remainder::initial_polynomials<Real>()
+{
+	return polynomial_of_initial_set;
+}
+
+template <>
+inline std::vector<Polynomial<Float> > & Symbolic_Remainder::initial_polynomials<Float>()
+{
+	return polynomial_of_initial_set_float;
+}
+
 
 
 class Computational_Setting
@@ -58,6 +94,7 @@ public:
 	bool setCutoffThreshold(const double threshold);
 	void setRemainderEstimation(const std::vector<Interval> & estimation);
 	void setQueueSize(const unsigned int m);
+	void setRefinementTolerance(const std::vector<double> & tolerance);
 
 	bool resetOrder(const unsigned int order);
 	bool resetOrder(const unsigned int order_min, const unsigned int order_max);
@@ -73,6 +110,83 @@ public:
 
 
 
+// Statistics of the remainder refinements in the flowpipe steps of a run.
+class Refinement_Statistics
+{
+public:
+	unsigned long steps;			// refined flowpipe steps
+	unsigned long iterations;		// Picard iterations spent on the refinements
+	unsigned long early_exits;		// refinements stopped by the tolerance while a remainder was still contracting
+	unsigned long capped;			// refinements stopped by MAX_REFINEMENT_STEPS
+	unsigned long extrapolations;	// extrapolated remainders verified by the Picard operator
+	unsigned long failed_extrapolations;	// extrapolated remainders it did not verify
+
+public:
+	Refinement_Statistics();
+	~Refinement_Statistics();
+
+	void clear();
+};
+
+extern Refinement_Statistics refinementStats;
+
+
+
+// Statistics of the trials of the adaptive step sizes in a run.
+class Stepsize_Statistics
+{
+public:
+	unsigned long accepted;			// steps accepted by the remainder check
+	unsigned long rejected;			// trials rejected by it
+
+public:
+	Stepsize_Statistics();
+	~Stepsize_Statistics();
+
+	void clear();
+};
+
+extern Stepsize_Statistics stepsizeStats;
+
+
+
+// The remainder refinement of a flowpipe step. A dimension is refined further as long as its width contracts by
+// STOP_RATIO. If it has a tolerance, the gain of the remaining iterations is extrapolated from the contraction rate
+// of the last two ones, and the dimension stops once the predicted gain is below the tolerance. The refinement then
+// also jumps ahead: the remainders are moved by EXTRAPOLATION_SHARE of that predicted gain, and are only kept if the
+// Picard operator maps them into themselves, otherwise the refinement goes on from the last verified ones. Every
+// accepted remainder is verified, so stopping earlier only keeps a wider but still safe remainder.
+class Remainder_Refinement
+{
+protected:
+	const std::vector<double> & tolerance;
+	std::vector<double> lastGain;	// the width gained by the last iteration, 0 if it is unknown
+	std::vector<double> rate;		// the contraction rate of the last iteration, 0 if it is unknown
+	std::vector<Interval> verified;	// the remainders before the last extrapolation
+	unsigned int dim;
+	unsigned int iterations;
+	unsigned int checked;			// the dimensions checked in the current iteration
+	bool bContracting;				// a dimension contracted by STOP_RATIO in the current iteration
+	bool bContinue;					// a dimension is refined further after the current iteration
+	bool bAccelerate;				// the remainders may still be extrapolated in this step
+	bool bExtrapolated;				// the current remainders are extrapolated and not verified yet
+
+public:
+	Remainder_Refinement(const Taylor_Model_Computation_Setting & tm_setting, const unsigned int d);
+	~Remainder_Refinement();
+
+	void next();
+	bool shrinking(const unsigned int i, const Interval & oldRemainder, const Interval & newRemainder);
+
+	template <class DATA_TYPE>
+	bool update(TaylorModelVec<DATA_TYPE> & x, const std::vector<Interval> & newRemainders);
+
+protected:
+	bool extrapolate(std::vector<Interval> & remainders, const std::vector<Interval> & oldRemainders);
+};
+
+
+
 class Flowpipe					// A flowpipe is represented by a composition of two Taylor models. The left Taylor model is the preconditioning part.
 {
 public:
@@ -86,6 +200,7 @@ public:
 	Flowpipe(const std::vector<Interval> & box);
 	Flowpipe(const TaylorModelVec<Real> & tmv_flowpipe, const std::vector<Interval> & flowpipe_domain, const Interval & cutoff_threshold);
 	Flowpipe(const Flowpipe & flowpipe);
+	Flowpipe(Flowpipe && flowpipe) noexcept;
 	~Flowpipe();
 
 	void clear();
@@ -106,6 +221,7 @@ public:
 	int safetyChecking(const std::vector<Constraint> & unsafeSet, const Taylor_Model_Computation_Setting & tm_setting, const Global_Computation_Setting & g_setting) const;
 
 	Flowpipe & operator = (const Flowpipe & flowpipe);
+	Flowpipe & operator = (Flowpipe && flowpipe) noexcept;
 
 
 	// interval remainders
@@ -194,6 +310,7 @@ public:
 public:
 	Result_of_Reachability();
 	Result_of_Reachability(const Result_of_Reachability & result);
+	Result_of_Reachability(Result_of_Reachability && result) noexcept;
 	~Result_of_Reachability();
 
 	void clear();
@@ -201,6 +318,7 @@ public:
 	void transformToTaylorModels(const Computational_Setting & c_setting);
 
 	Result_of_Reachability & operator = (const Result_of_Reachability & result);
+	Result_of_Reachability & operator = (Result_of_Reachability && result) noexcept;
 };
 
 
@@ -446,6 +564,13 @@ public:
 	void reach(Result_of_Reachability & result, Computational_Setting & setting, const std::vector<Flowpipe> & initialSets, const std::vector<Constraint> & unsafeSet) const;
 
 	void reach(Result_of_Reachability & result, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const;
+
+	// the same reachability analysis which only keeps the flowpipe at the end of the time horizon, evaluated at the end of its step,
+	// the memory does not grow with the number of steps. fp_end_of_time is empty if no step could be computed.
+	int reach_end_of_time(Flowpipe & fp_end_of_time, unsigned long & num_of_flowpipes, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const;
+
+	// only the status, the number of flowpipes and fp_end_of_time are set in the result
+	void reach_end_of_time(Result_of_Reachability & result, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const;
 };
 
 
@@ -505,6 +630,13 @@ public:
 	void reach(Result_of_Reachability & result, Computational_Setting & setting, const std::vector<Flowpipe> & initialSets, const std::vector<Constraint> & unsafeSet) const;
 
 	void reach(Result_of_Reachability & result, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const;
+
+	// the same reachability analysis which only keeps the flowpipe at the end of the time horizon, evaluated at the end of its step,
+	// the memory does not grow with the number of steps. fp_end_of_time is empty if no step could be computed.
+	int reach_end_of_time(Flowpipe & fp_end_of_time, unsigned long & num_of_flowpipes, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const;
+
+	// only the status, the number of flowpipes and fp_end_of_time are set in the result
+	void reach_end_of_time(Result_of_Reachability & result, Computational_Setting & setting, const Flowpipe & initialSet, const std::vector<Constraint> & unsafeSet) const;
 };
 
 
@@ -13,32 +13,133 @@
 
 #include "Interval.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_DISPATCH
+#include <immintrin.h>
+#endif
+
 using namespace flowstar;
 
 mpfr_prec_t intervalNumPrecision = normal_precision;
+bool roundingErrorSweep = false;
+
+
+// A number of the current precision, with its significand in limbs if it fits. Only a number on the heap is cleared.
+static inline void init_number(mpfr_ptr x, mp_limb_t *limbs)
+{
+	if(intervalNumPrecision <= INLINE_PRECISION)
+	{
+		mpfr_custom_init(limbs, intervalNumPrecision);
+		mpfr_custom_init_set(x, MPFR_ZERO_KIND, 0, intervalNumPrecision, limbs);
+	}
+	else
+	{
+		mpfr_init2(x, intervalNumPrecision);
+	}
+}
+
+static inline void clear_number(mpfr_ptr x, mp_limb_t *limbs)
+{
+	if(mpfr_custom_get_significand(x) != limbs)
+	{
+		mpfr_clear(x);
+	}
+}
+
+// The numbers of a higher precision which are free, kept for the temporaries of the thread.
+class Scratch_Pool
+{
+public:
+	std::vector<__mpfr_struct> numbers;
+
+	~Scratch_Pool()
+	{
+		for(unsigned int i=0; i<numbers.size(); ++i)
+		{
+			mpfr_clear(&numbers[i]);
+		}
+	}
+};
+
+static thread_local Scratch_Pool scratchPool;
+
+// N temporaries of the current precision. They are on the stack if they fit, otherwise taken from the pool
+// and given back at the end of the scope, so the arithmetic does not allocate.
+template <unsigned int N>
+class Scratch
+{
+protected:
+	mpfr_t values[N];
+	mp_limb_t limbs[N][INLINE_LIMBS];
+	bool bPooled;
+
+public:
+	Scratch()
+	{
+		bPooled = intervalNumPrecision > INLINE_PRECISION;
+
+		for(unsigned int i=0; i<N; ++i)
+		{
+			if(!bPooled)
+			{
+				init_number(values[i], limbs[i]);
+			}
+			else if(scratchPool.numbers.size() > 0)
+			{
+				values[i][0] = scratchPool.numbers.back();
+				scratchPool.numbers.pop_back();
+
+				if(mpfr_get_prec(values[i]) != intervalNumPrecision)
+				{
+					mpfr_set_prec(values[i], intervalNumPrecision);
+				}
+			}
+			else
+			{
+				mpfr_init2(values[i], intervalNumPrecision);
+			}
+		}
+	}
+
+	~Scratch()
+	{
+		if(bPooled)
+		{
+			for(unsigned int i=0; i<N; ++i)
+			{
+				scratchPool.numbers.push_back(values[i][0]);
+			}
+		}
+	}
+
+	mpfr_ptr operator [] (const unsigned int i)
+	{
+		return values[i];
+	}
+};
 
 
 Real::Real()
 {
-	mpfr_init2(value, intervalNumPrecision);
+	init_number(value, limbs);
 	mpfr_set_ui(value, 0L, MPFR_RNDD);
 }
 
 Real::Real(const double d)
 {
-	mpfr_init2(value, intervalNumPrecision);
+	init_number(value, limbs);
 	mpfr_set_d(value, d, MPFR_RNDN);
 }
 
 Real::Real(const Real & real)
 {
-	mpfr_init2(value, intervalNumPrecision);
+	init_number(value, limbs);
 	mpfr_set(value, real.value, MPFR_RNDN);
 }
 
 Real::~Real()
 {
-	mpfr_clear(value);
+	clear_number(value, limbs);
 }
 
 void Real::set(const double c)
@@ -92,8 +193,8 @@ void Real::abs(Real & r) const
 
 double Real::abs() const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_abs(tmp, value, MPFR_RNDU);
 
@@ -102,8 +203,8 @@ double Real::abs() const
 
 double Real::mag() const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_abs(tmp, value, MPFR_RNDU);
 
@@ -646,7 +747,8 @@ Real & Real::operator = (const double c)
 
 Interval::Interval()
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	init_number(lo, limbs);
+	init_number(up, limbs + INLINE_LIMBS);
 
 	mpfr_set_d(lo, 0.0, MPFR_RNDD);
 	mpfr_set_d(up, 0.0, MPFR_RNDU);
@@ -654,7 +756,8 @@ Interval::Interval()
 
 Interval::Interval(const double c)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	init_number(lo, limbs);
+	init_number(up, limbs + INLINE_LIMBS);
 
 	mpfr_set_d(lo, c, MPFR_RNDD);
 	mpfr_set_d(up, c, MPFR_RNDU);
@@ -662,7 +765,8 @@ Interval::Interval(const double c)
 
 Interval::Interval(const Real & r)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	init_number(lo, limbs);
+	init_number(up, limbs + INLINE_LIMBS);
 
 	mpfr_set(lo, r.value, MPFR_RNDD);
 	mpfr_set(up, r.value, MPFR_RNDU);
@@ -670,7 +774,8 @@ Interval::Interval(const Real & r)
 
 Interval::Interval(const double l, const double u)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	init_number(lo, limbs);
+	init_number(up, limbs + INLINE_LIMBS);
 
 	mpfr_set_d(lo, l, MPFR_RNDD);
 	mpfr_set_d(up, u, MPFR_RNDU);
@@ -678,7 +783,8 @@ Interval::Interval(const double l, const double u)
 
 Interval::Interval(const Real & c, const Real & r)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	init_number(lo, limbs);
+	init_number(up, limbs + INLINE_LIMBS);
 
 	mpfr_add(up, c.value, r.value, MPFR_RNDU);
 	mpfr_sub(lo, c.value, r.value, MPFR_RNDD);
@@ -686,7 +792,8 @@ Interval::Interval(const Real & c, const Real & r)
 
 Interval::Interval(const Real & l, const Real & u, const int n)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	init_number(lo, limbs);
+	init_number(up, limbs + INLINE_LIMBS);
 
 	mpfr_set(up, u.value, MPFR_RNDU);
 	mpfr_set(lo, l.value, MPFR_RNDD);
@@ -694,7 +801,8 @@ Interval::Interval(const Real & l, const Real & u, const int n)
 
 Interval::Interval(const char *strLo, const char *strUp)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	init_number(lo, limbs);
+	init_number(up, limbs + INLINE_LIMBS);
 
 	mpfr_set_str(lo, strLo, 10, MPFR_RNDD);
 	mpfr_set_str(up, strUp, 10, MPFR_RNDU);
@@ -702,7 +810,8 @@ Interval::Interval(const char *strLo, const char *strUp)
 
 Interval::Interval(const Interval & I)
 {
-	mpfr_inits2(intervalNumPrecision, lo, up, (mpfr_ptr) 0);
+	init_number(lo, limbs);
+	init_number(up, limbs + INLINE_LIMBS);
 
 	mpfr_set(lo, I.lo, MPFR_RNDD);
 	mpfr_set(up, I.up, MPFR_RNDU);
@@ -710,8 +819,8 @@ Interval::Interval(const Interval & I)
 
 Interval::~Interval()
 {
-	mpfr_clear(lo);
-	mpfr_clear(up);
+	clear_number(lo, limbs);
+	clear_number(up, limbs + INLINE_LIMBS);
 }
 
 bool Interval::isZero() const
@@ -730,8 +839,8 @@ bool Interval::isZero() const
 
 bool Interval::isSingle() const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_sub(tmp, up, lo, MPFR_RNDU);
 
@@ -785,8 +894,8 @@ void Interval::setSup(const Interval & S)
 
 void Interval::split(Interval & left, Interval & right) const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_set(left.lo, lo, MPFR_RNDD);
 	mpfr_add(tmp, lo, up, MPFR_RNDU);
@@ -795,14 +904,12 @@ void Interval::split(Interval & left, Interval & right) const
 	mpfr_set(right.up, up, MPFR_RNDU);
 	mpfr_add(tmp, lo, up, MPFR_RNDD);
 	mpfr_div_d(right.lo, tmp, 2.0, MPFR_RNDD);
-
-	mpfr_clear(tmp);
 }
 
 void Interval::split(std::list<Interval> & result, const int n) const
 {
-	mpfr_t inc, w, newup, newlo;
-	mpfr_inits2(intervalNumPrecision, inc, w, newup, newlo, (mpfr_ptr) 0);
+	Scratch<4> scratch;
+	mpfr_ptr inc = scratch[0], w = scratch[1], newup = scratch[2], newlo = scratch[3];
 
 	mpfr_sub(w, up, lo, MPFR_RNDU);
 	mpfr_div_si(inc, w, (long)n, MPFR_RNDU);
@@ -860,22 +967,21 @@ void Interval::inf(Real & l) const
 
 double Interval::midpoint() const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_add(tmp, lo, up, MPFR_RNDN);
 	mpfr_div_d(tmp, tmp, 2.0, MPFR_RNDN);
 
 	double dMidpoint = mpfr_get_d(tmp, MPFR_RNDN);
-	mpfr_clear(tmp);
 
 	return dMidpoint;
 }
 
 void Interval::midpoint(Interval & M) const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_add(tmp, lo, up, MPFR_RNDU);
 	mpfr_div_d(tmp, tmp, 2.0, MPFR_RNDU);
@@ -886,40 +992,32 @@ void Interval::midpoint(Interval & M) const
 	mpfr_div_d(tmp, tmp, 2.0, MPFR_RNDD);
 
 	mpfr_set(M.lo, tmp, MPFR_RNDD);
-
-	mpfr_clear(tmp);
 }
 
 void Interval::midpoint(Real & mid) const
 {
-	mpfr_t tmp;
-
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_add(tmp, lo, up, MPFR_RNDN);
 	mpfr_div_d(mid.value, tmp, 2, MPFR_RNDN);
-
-	mpfr_clear(tmp);
 }
 
 void Interval::toCenterForm(Real & center, Real & radius) const
 {
-	mpfr_t tmp1;
-
-	mpfr_inits2(intervalNumPrecision, tmp1, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp1 = scratch[0];
 
 	mpfr_add(tmp1, lo, up, MPFR_RNDN);
 	mpfr_div_d(center.value, tmp1, 2.0, MPFR_RNDN);
 
 	mpfr_sub(radius.value, up, center.value, MPFR_RNDU);
-
-	mpfr_clear(tmp1);
 }
 
 void Interval::remove_midpoint(Interval & M)
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_add(tmp, lo, up, MPFR_RNDU);
 	mpfr_div_d(tmp, tmp, 2.0, MPFR_RNDU);
@@ -933,8 +1031,6 @@ void Interval::remove_midpoint(Interval & M)
 
 	mpfr_sub(lo, lo, M.up, MPFR_RNDD);
 	mpfr_sub(up, up, M.lo, MPFR_RNDU);
-
-	mpfr_clear(tmp);
 }
 
 void Interval::remove_midpoint(Real & c)
@@ -948,8 +1044,8 @@ void Interval::remove_midpoint(Real & c)
 
 double Interval::remove_midpoint()
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_add(tmp, lo, up, MPFR_RNDN);
 	mpfr_div_d(tmp, tmp, 2.0, MPFR_RNDN);
@@ -959,8 +1055,6 @@ double Interval::remove_midpoint()
 
 	double c = mpfr_get_d(tmp, MPFR_RNDN);
 
-	mpfr_clear(tmp);
-
 	return c;
 }
 
@@ -1016,8 +1110,8 @@ void Interval::bloat(const Real & e)
 
 bool Interval::within(const Interval & I, const double e) const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	if(mpfr_cmp(up, I.up) >= 0)
 	{
@@ -1033,7 +1127,6 @@ bool Interval::within(const Interval & I, const double e) const
 
 	if(d > e)
 	{
-		mpfr_clear(tmp);
 		return false;
 	}
 
@@ -1051,40 +1144,35 @@ bool Interval::within(const Interval & I, const double e) const
 
 	if(d > e)
 	{
-		mpfr_clear(tmp);
 		return false;
 	}
 	else
 	{
-		mpfr_clear(tmp);
 		return true;
 	}
 }
 
 double Interval::width() const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_sub(tmp, up, lo, MPFR_RNDU);
 
 	double dWidth = mpfr_get_d(tmp, MPFR_RNDU);
-	mpfr_clear(tmp);
 
 	return dWidth;
 }
 
 void Interval::width(Interval & W) const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_sub(tmp, up, lo, MPFR_RNDU);
 
 	mpfr_set(W.lo, tmp, MPFR_RNDD);
 	mpfr_set(W.up, tmp, MPFR_RNDU);
-
-	mpfr_clear(tmp);
 }
 
 double Interval::mag() const
@@ -1100,8 +1188,8 @@ double Interval::mag() const
 
 void Interval::mag(Real & m) const
 {
-	mpfr_t tmp1, tmp2;
-	mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
+	Scratch<2> scratch;
+	mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1];
 
 	mpfr_abs(tmp1, lo, MPFR_RNDU);
 	mpfr_abs(tmp2, up, MPFR_RNDU);
@@ -1114,15 +1202,12 @@ void Interval::mag(Real & m) const
 	{
 		mpfr_set(m.value, tmp2, MPFR_RNDU);
 	}
-
-	mpfr_clear(tmp1);
-	mpfr_clear(tmp2);
 }
 
 void Interval::mag(Interval & M) const
 {
-	mpfr_t tmp1, tmp2;
-	mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
+	Scratch<2> scratch;
+	mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1];
 
 	mpfr_abs(tmp1, lo, MPFR_RNDU);
 	mpfr_abs(tmp2, up, MPFR_RNDU);
@@ -1137,15 +1222,12 @@ void Interval::mag(Interval & M) const
 		mpfr_set(M.lo, tmp2, MPFR_RNDD);
 		mpfr_set(M.up, tmp2, MPFR_RNDU);
 	}
-
-	mpfr_clear(tmp1);
-	mpfr_clear(tmp2);
 }
 
 void Interval::abs(Interval & result) const
 {
-	mpfr_t tmp1, tmp2;
-	mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
+	Scratch<2> scratch;
+	mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1];
 
 	mpfr_abs(tmp1, lo, MPFR_RNDD);
 	mpfr_abs(tmp2, up, MPFR_RNDD);
@@ -1170,15 +1252,12 @@ void Interval::abs(Interval & result) const
 	{
 		mpfr_set(result.up, tmp2, MPFR_RNDU);
 	}
-
-	mpfr_clear(tmp1);
-	mpfr_clear(tmp2);
 }
 
 void Interval::abs_assign()
 {
-	mpfr_t tmp1, tmp2, newLo, newUp;
-	mpfr_inits2(intervalNumPrecision, tmp1, tmp2, newLo, newUp, (mpfr_ptr) 0);
+	Scratch<4> scratch;
+	mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1], newLo = scratch[2], newUp = scratch[3];
 
 	mpfr_abs(tmp1, lo, MPFR_RNDD);
 	mpfr_abs(tmp2, up, MPFR_RNDD);
@@ -1206,11 +1285,6 @@ void Interval::abs_assign()
 
 	mpfr_set(lo, newLo, MPFR_RNDD);
 	mpfr_set(up, newUp, MPFR_RNDU);
-
-	mpfr_clear(tmp1);
-	mpfr_clear(tmp2);
-	mpfr_clear(newLo);
-	mpfr_clear(newUp);
 }
 
 bool Interval::subseteq(const Interval & I) const
@@ -1293,14 +1367,13 @@ bool Interval::lessThanEq(const Real & r) const
 
 double Interval::toDouble() const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_add(tmp, lo, up, MPFR_RNDN);
 	mpfr_div_d(tmp, tmp, 2.0, MPFR_RNDN);
 
 	double dMidpoint = mpfr_get_d(tmp, MPFR_RNDN);
-	mpfr_clear(tmp);
 
 	return dMidpoint;
 }
@@ -1331,14 +1404,13 @@ std::string Interval::toString() const
 /*
 Interval::operator double() const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_add(tmp, lo, up, MPFR_RNDN);
 	mpfr_div_d(tmp, tmp, 2.0, MPFR_RNDN);
 
 	double dMidpoint = mpfr_get_d(tmp, MPFR_RNDN);
-	mpfr_clear(tmp);
 
 	return dMidpoint;
 }
@@ -1420,8 +1492,8 @@ Interval & Interval::operator -= (const double c)
 
 Interval & Interval::operator *= (const Interval & I)
 {
-	mpfr_t result_lo, result_up, tmp1, tmp2;
-	mpfr_inits2(intervalNumPrecision, result_lo, result_up, tmp1, tmp2, (mpfr_ptr) 0);
+	Scratch<4> scratch;
+	mpfr_ptr result_lo = scratch[0], result_up = scratch[1], tmp1 = scratch[2], tmp2 = scratch[3];
 
 	if(mpfr_cmp_ui(lo, 0L) >= 0)
 	{
@@ -1502,7 +1574,6 @@ Interval & Interval::operator *= (const Interval & I)
 	mpfr_set(lo, result_lo, MPFR_RNDD);
 	mpfr_set(up, result_up, MPFR_RNDU);
 
-	mpfr_clears(result_lo, result_up, tmp1, tmp2, (mpfr_ptr) 0);
 
 	return *this;
 }
@@ -1781,14 +1852,12 @@ void Interval::rec(Interval & result) const
 	}
 	else
 	{
-		mpfr_t tmp;
-		mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+		Scratch<1> scratch;
+		mpfr_ptr tmp = scratch[0];
 		mpfr_set(tmp, lo, MPFR_RNDD);
 
 		mpfr_si_div(result.lo, 1L, up, MPFR_RNDD);
 		mpfr_si_div(result.up, 1L, tmp, MPFR_RNDU);
-
-		mpfr_clear(tmp);
 	}
 }
 
@@ -1868,8 +1937,8 @@ void Interval::div_assign(const double c)
 
 void Interval::mul_add(Interval *result, const Interval *intVec, const int size)
 {
-	mpfr_t tmp1, tmp2, tmp_up, tmp_lo;
-	mpfr_inits2(intervalNumPrecision, tmp_up, tmp_lo, tmp1, tmp2, (mpfr_ptr) 0);
+	Scratch<4> scratch;
+	mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1], tmp_up = scratch[2], tmp_lo = scratch[3];
 
 	if(mpfr_cmp_ui(lo, 0L) >= 0)
 	{
@@ -1964,8 +2033,6 @@ void Interval::mul_add(Interval *result, const Interval *intVec, const int size)
 			mpfr_add(result[i].up, result[i].up, tmp_up, MPFR_RNDU);
 		}
 	}
-
-	mpfr_clears(tmp_lo, tmp_up, tmp1, tmp2, (mpfr_ptr) 0);
 }
 
 Interval Interval::pow(const int n) const
@@ -1991,8 +2058,8 @@ Interval Interval::pow(const int n) const
 		}
 		else									// lo < 0 < up
 		{
-			mpfr_t tmp1, tmp2;
-			mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
+			Scratch<2> scratch;
+			mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1];
 
 			mpfr_pow_ui(tmp1, lo, n, MPFR_RNDU);
 			mpfr_pow_ui(tmp2, up, n, MPFR_RNDU);
@@ -2006,9 +2073,6 @@ Interval Interval::pow(const int n) const
 			{
 				mpfr_set(result.up, tmp2, MPFR_RNDU);
 			}
-
-			mpfr_clear(tmp1);
-			mpfr_clear(tmp2);
 		}
 	}
 
@@ -2028,8 +2092,8 @@ Interval Interval::exp() const
 
 Interval Interval::sin() const
 {
-	mpfr_t pi_up, pi_lo, tmp_up, tmp_lo;
-	mpfr_inits2(intervalNumPrecision, pi_up, pi_lo, tmp_up, tmp_lo, (mpfr_ptr) 0);
+	Scratch<4> scratch;
+	mpfr_ptr pi_up = scratch[0], pi_lo = scratch[1], tmp_up = scratch[2], tmp_lo = scratch[3];
 	mpfr_set_str(pi_up, str_pi_up, 10, MPFR_RNDU);
 	mpfr_set_str(pi_lo, str_pi_lo, 10, MPFR_RNDD);
 
@@ -2063,8 +2127,8 @@ Interval Interval::sin() const
 			modLo += 4;
 
 		Interval result;
-		mpfr_t tmp1, tmp2;
-		mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
+		Scratch<2> scratch;
+		mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1];
 
 		switch(modLo)
 		{
@@ -2230,16 +2294,14 @@ Interval Interval::sin() const
 			break;
 		}
 
-		mpfr_clear(tmp1);
-		mpfr_clear(tmp2);
 		return result;
 	}
 }
 
 Interval Interval::cos() const
 {
-	mpfr_t pi_up, pi_lo, tmp_up, tmp_lo;
-	mpfr_inits2(intervalNumPrecision, pi_up, pi_lo, tmp_up, tmp_lo, (mpfr_ptr) 0);
+	Scratch<4> scratch;
+	mpfr_ptr pi_up = scratch[0], pi_lo = scratch[1], tmp_up = scratch[2], tmp_lo = scratch[3];
 	mpfr_set_str(pi_up, str_pi_up, 10, MPFR_RNDU);
 	mpfr_set_str(pi_lo, str_pi_lo, 10, MPFR_RNDD);
 
@@ -2273,8 +2335,8 @@ Interval Interval::cos() const
 			modLo += 4;
 
 		Interval result;
-		mpfr_t tmp1, tmp2;
-		mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
+		Scratch<2> scratch;
+		mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1];
 
 		switch(modLo)
 		{
@@ -2440,8 +2502,6 @@ Interval Interval::cos() const
 			break;
 		}
 
-		mpfr_clear(tmp1);
-		mpfr_clear(tmp2);
 		return result;
 	}
 }
@@ -2464,8 +2524,8 @@ Interval Interval::log() const
 
 void Interval::pow_assign(const int n)
 {
-	mpfr_t tmp1, tmp2;
-	mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
+	Scratch<2> scratch;
+	mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1];
 
 	if(n % 2 == 1)		// n is odd
 	{
@@ -2505,9 +2565,6 @@ void Interval::pow_assign(const int n)
 			mpfr_set_si(lo, 0L, MPFR_RNDD);
 		}
 	}
-
-	mpfr_clear(tmp1);
-	mpfr_clear(tmp2);
 }
 
 void Interval::exp_assign()
@@ -2518,8 +2575,8 @@ void Interval::exp_assign()
 
 void Interval::sin_assign()
 {
-	mpfr_t pi_up, pi_lo, tmp_up, tmp_lo;
-	mpfr_inits2(intervalNumPrecision, pi_up, pi_lo, tmp_up, tmp_lo, (mpfr_ptr) 0);
+	Scratch<4> scratch;
+	mpfr_ptr pi_up = scratch[0], pi_lo = scratch[1], tmp_up = scratch[2], tmp_lo = scratch[3];
 	mpfr_set_str(pi_up, str_pi_up, 10, MPFR_RNDU);
 	mpfr_set_str(pi_lo, str_pi_lo, 10, MPFR_RNDD);
 
@@ -2553,8 +2610,8 @@ void Interval::sin_assign()
 			modLo += 4;
 
 		Interval result;
-		mpfr_t tmp1, tmp2;
-		mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
+		Scratch<2> scratch;
+		mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1];
 
 		switch(modLo)
 		{
@@ -2720,16 +2777,14 @@ void Interval::sin_assign()
 			break;
 		}
 
-		mpfr_clear(tmp1);
-		mpfr_clear(tmp2);
 		*this = result;
 	}
 }
 
 void Interval::cos_assign()
 {
-	mpfr_t pi_up, pi_lo, tmp_up, tmp_lo;
-	mpfr_inits2(intervalNumPrecision, pi_up, pi_lo, tmp_up, tmp_lo, (mpfr_ptr) 0);
+	Scratch<4> scratch;
+	mpfr_ptr pi_up = scratch[0], pi_lo = scratch[1], tmp_up = scratch[2], tmp_lo = scratch[3];
 	mpfr_set_str(pi_up, str_pi_up, 10, MPFR_RNDU);
 	mpfr_set_str(pi_lo, str_pi_lo, 10, MPFR_RNDD);
 
@@ -2763,8 +2818,8 @@ void Interval::cos_assign()
 			modLo += 4;
 
 		Interval result;
-		mpfr_t tmp1, tmp2;
-		mpfr_inits2(intervalNumPrecision, tmp1, tmp2, (mpfr_ptr) 0);
+		Scratch<2> scratch;
+		mpfr_ptr tmp1 = scratch[0], tmp2 = scratch[1];
 
 		switch(modLo)
 		{
@@ -2930,8 +2985,6 @@ void Interval::cos_assign()
 			break;
 		}
 
-		mpfr_clear(tmp1);
-		mpfr_clear(tmp2);
 		*this = result;
 	}
 }
@@ -2952,8 +3005,8 @@ void Interval::log_assign()
 
 double Interval::widthRatio(const Interval & I) const
 {
-	mpfr_t width1, width2, ratio;
-	mpfr_inits2(intervalNumPrecision, width1, width2, ratio, (mpfr_ptr) 0);
+	Scratch<3> scratch;
+	mpfr_ptr width1 = scratch[0], width2 = scratch[1], ratio = scratch[2];
 
 	mpfr_sub(width1, up, lo, MPFR_RNDU);
 	mpfr_sub(width2, I.up, I.lo, MPFR_RNDU);
@@ -2962,9 +3015,6 @@ double Interval::widthRatio(const Interval & I) const
 
 	double result = mpfr_get_d(ratio, MPFR_RNDU);
 
-	mpfr_clear(width1);
-	mpfr_clear(width2);
-	mpfr_clear(ratio);
 
 	return result;
 }
@@ -3002,21 +3052,19 @@ void Interval::output(FILE * fp, const char * msg, const char * msg2) const
 
 void Interval::output_midpoint(FILE * fp, const int n) const
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_add(tmp, lo, up, MPFR_RNDN);
 	mpfr_div_d(tmp, tmp, 2.0, MPFR_RNDN);
 
 	mpfr_out_str(fp, 10, n, tmp, MPFR_RNDD);
-
-	mpfr_clear(tmp);
 }
 
 void Interval::round(Interval & remainder)
 {
-	mpfr_t tmp;
-	mpfr_inits2(intervalNumPrecision, tmp, (mpfr_ptr) 0);
+	Scratch<1> scratch;
+	mpfr_ptr tmp = scratch[0];
 
 	mpfr_add(tmp, lo, up, MPFR_RNDN);
 	mpfr_div_d(tmp, tmp, 2.0, MPFR_RNDN);
@@ -3026,8 +3074,6 @@ void Interval::round(Interval & remainder)
 
 	mpfr_set(lo, tmp, MPFR_RNDD);
 	mpfr_set(up, tmp, MPFR_RNDU);
-
-	mpfr_clear(tmp);
 }
 
 void Interval::shrink_up(const double d)
@@ -3052,6 +3098,439 @@ void Interval::shrink_lo(const double d)
 
 
 
+/*
+ * The error-free transformations of the Float arithmetic: the rounding error of a sum is exact by TwoSum,
+ * and the one of a product or a quotient by a fused multiply-add, unless the result is so small that the
+ * error underflows. Below FLOAT_TINY the bounds are therefore bumped by one more ulp.
+ */
+#define FLOAT_TINY		(2 * DBL_MIN / DBL_EPSILON)	// 2^-969
+
+static inline double two_sum_error(const double a, const double b, const double s)
+{
+	double t = s - a;
+	return (a - (s - t)) + (b - t);
+}
+
+static inline double add_up(const double a, const double b)
+{
+	double s = a + b;
+	return two_sum_error(a, b, s) > 0 ? std::nextafter(s, std::numeric_limits<double>::infinity()) : s;
+}
+
+static inline double sub_down(const double a, const double b)
+{
+	double s = a - b;
+	return two_sum_error(a, -b, s) < 0 ? std::nextafter(s, -std::numeric_limits<double>::infinity()) : s;
+}
+
+// a * b rounded upward for a, b >= 0
+static inline double mul_up(const double a, const double b)
+{
+	if(a == 0 || b == 0)
+	{
+		return 0;
+	}
+
+	double p = a * b;
+
+	if(std::fma(a, b, -p) > 0 || p < FLOAT_TINY)
+	{
+		p = std::nextafter(p, std::numeric_limits<double>::infinity());
+	}
+
+	return p;
+}
+
+// a / b rounded upward for a >= 0, b > 0
+static inline double div_up(const double a, const double b)
+{
+	if(a == 0)
+	{
+		return 0;
+	}
+
+	double q = a / b;
+
+	if(std::fma(-q, b, a) > 0 || q < FLOAT_TINY || a < FLOAT_TINY)
+	{
+		q = std::nextafter(q, std::numeric_limits<double>::infinity());
+	}
+
+	return q;
+}
+
+// the error of value as an approximation of the numbers in [lo, up]
+static inline double distance_up(const double value, const double lo, const double up)
+{
+	double e = std::max(-sub_down(lo, value), -sub_down(value, up));
+	return std::isnan(e) ? std::numeric_limits<double>::infinity() : std::max(e, 0.0);
+}
+
+Float::Float() : value(0), err(0)
+{
+}
+
+Float::Float(const double d) : value(d), err(0)
+{
+}
+
+Float::Float(const Real & r)
+{
+	value = r.toDouble();
+	err = distance_up(value, r.getValue_RNDD(), r.getValue_RNDU());
+}
+
+Float::Float(const Interval & I)
+{
+	value = I.midpoint();
+	err = distance_up(value, I.inf(), I.sup());
+}
+
+Float::Float(const Float & f) : value(f.value), err(f.err)
+{
+}
+
+Float::~Float()
+{
+}
+
+void Float::set(const double c)
+{
+	value = c;
+	err = 0;
+}
+
+bool Float::isZero() const
+{
+	return value == 0 && err == 0;
+}
+
+bool Float::belongsTo(const Interval & I) const
+{
+	return getValue_RNDD() >= I.inf() && getValue_RNDU() <= I.sup();
+}
+
+double Float::error() const
+{
+	return err;
+}
+
+double Float::take_error()
+{
+	double e = err;
+	err = 0;
+	return e;
+}
+
+double Float::getValue_RNDD() const
+{
+	return err == 0 ? value : sub_down(value, err);
+}
+
+double Float::getValue_RNDU() const
+{
+	return err == 0 ? value : add_up(value, err);
+}
+
+void Float::mag(Real & r) const
+{
+	r = mag();
+}
+
+double Float::mag() const
+{
+	return add_up(std::fabs(value), err);
+}
+
+double Float::abs() const
+{
+	return mag();
+}
+
+void Float::abs_assign()
+{
+	value = std::fabs(value);
+}
+
+void Float::to_sym_int(Interval & I) const
+{
+	double m = mag();
+	I.set(-m, m);
+}
+
+void Float::pow_assign(const int n)
+{
+	Float base = *this;
+	*this = 1;
+
+	for(int d = n; d > 0; d >>= 1)
+	{
+		if(d & 1)
+		{
+			*this *= base;
+		}
+
+		if(d > 1)
+		{
+			base *= base;
+		}
+	}
+}
+
+void Float::rec_assign()
+{
+	*this = Float(1) / *this;
+}
+
+// the transcendental functions are evaluated in interval arithmetic
+void Float::sin_assign()
+{
+	*this = Float(Interval(*this).sin());
+}
+
+void Float::cos_assign()
+{
+	*this = Float(Interval(*this).cos());
+}
+
+void Float::exp_assign()
+{
+	*this = Float(Interval(*this).exp());
+}
+
+void Float::log_assign()
+{
+	*this = Float(Interval(*this).log());
+}
+
+void Float::sqrt_assign()
+{
+	Interval I = *this;
+	I.sqrt_assign();
+	*this = Float(I);
+}
+
+void Float::sin(Float & c) const
+{
+	c = *this;
+	c.sin_assign();
+}
+
+void Float::cos(Float & c) const
+{
+	c = *this;
+	c.cos_assign();
+}
+
+void Float::exp(Float & c) const
+{
+	c = *this;
+	c.exp_assign();
+}
+
+void Float::log(Float & c) const
+{
+	c = *this;
+	c.log_assign();
+}
+
+void Float::sqrt(Float & c) const
+{
+	c = *this;
+	c.sqrt_assign();
+}
+
+void Float::output(FILE *fp) const
+{
+	fprintf(fp, "%.20e", value);
+}
+
+void Float::dump(FILE *fp) const
+{
+	fprintf(fp, "%.20e", value);
+}
+
+double Float::toDouble() const
+{
+	return value;
+}
+
+Real Float::toReal() const
+{
+	return Real(value);
+}
+
+std::string Float::toString() const
+{
+	std::ostringstream oss;
+
+	oss << std::setprecision(15) << std::scientific << value;
+
+	return oss.str();
+}
+
+Float::operator Interval () const
+{
+	return Interval(getValue_RNDD(), getValue_RNDU());
+}
+
+Interval Float::operator * (const Interval & I) const
+{
+	return Interval(*this) * I;
+}
+
+Float & Float::operator += (const Float & f)
+{
+	double s = value + f.value;
+	double e = std::fabs(two_sum_error(value, f.value, s));
+
+	err = std::isfinite(s) ? add_up(add_up(err, f.err), e) : std::numeric_limits<double>::infinity();
+	value = s;
+
+	return *this;
+}
+
+Float & Float::operator -= (const Float & f)
+{
+	return *this += -f;
+}
+
+Float & Float::operator *= (const Float & f)
+{
+	double p = value * f.value;
+
+	if(!std::isfinite(p))
+	{
+		value = p;
+		err = std::numeric_limits<double>::infinity();
+		return *this;
+	}
+
+	// |x*y - p| <= |x - value|*|f.value| + |value|*|y - f.value| + |x - value|*|y - f.value| + |value*f.value - p|
+	double e = std::fabs(std::fma(value, f.value, -p));
+
+	if(std::fabs(p) < FLOAT_TINY)
+	{
+		e = add_up(e, std::numeric_limits<double>::denorm_min());
+	}
+
+	e = add_up(e, mul_up(err, std::fabs(f.value)));
+	e = add_up(e, mul_up(std::fabs(value), f.err));
+	e = add_up(e, mul_up(err, f.err));
+
+	value = p;
+	err = e;
+
+	return *this;
+}
+
+Float & Float::operator /= (const Float & f)
+{
+	double q = value / f.value;
+	double d = f.err == 0 ? std::fabs(f.value) : sub_down(std::fabs(f.value), f.err);
+
+	if(!std::isfinite(q) || !(d > 0))
+	{
+		value = q;
+		err = std::numeric_limits<double>::infinity();
+		return *this;
+	}
+
+	// |x/y - q| <= (|x - value| + |q|*|y - f.value| + |value - q*f.value|) / (|f.value| - f.err)
+	double r = std::fabs(std::fma(-q, f.value, value));
+
+	if(std::fabs(q) < FLOAT_TINY || std::fabs(value) < FLOAT_TINY)
+	{
+		r = add_up(r, std::numeric_limits<double>::denorm_min());
+	}
+
+	double e = add_up(r, err);
+	e = add_up(e, mul_up(std::fabs(q), f.err));
+
+	value = q;
+	err = div_up(e, d);
+
+	return *this;
+}
+
+Float Float::operator - () const
+{
+	Float result = *this;
+	result.value = -value;
+
+	return result;
+}
+
+Float Float::operator + (const Float & f) const
+{
+	Float result = *this;
+	result += f;
+
+	return result;
+}
+
+Float Float::operator - (const Float & f) const
+{
+	Float result = *this;
+	result -= f;
+
+	return result;
+}
+
+Float Float::operator * (const Float & f) const
+{
+	Float result = *this;
+	result *= f;
+
+	return result;
+}
+
+Float Float::operator / (const Float & f) const
+{
+	Float result = *this;
+	result /= f;
+
+	return result;
+}
+
+bool Float::operator == (const Float & f) const
+{
+	return value == f.value && err == 0 && f.err == 0;
+}
+
+bool Float::operator != (const Float & f) const
+{
+	return !(*this == f);
+}
+
+bool Float::operator == (const double c) const
+{
+	return value == c && err == 0;
+}
+
+bool Float::operator != (const double c) const
+{
+	return !(*this == c);
+}
+
+Float & Float::operator = (const Float & f)
+{
+	value = f.value;
+	err = f.err;
+
+	return *this;
+}
+
+Float & Float::operator = (const double c)
+{
+	value = c;
+	err = 0;
+
+	return *this;
+}
+
+
+
 namespace flowstar
 {
 
@@ -3076,6 +3555,14 @@ std::ostream & operator << (std::ostream & output, const Interval & I)
 	return output;
 }
 
+std::ostream & operator << (std::ostream & output, const Float & f)
+{
+	output.precision(15);
+	output << std::scientific << f.value;
+
+	return output;
+}
+
 
 Real operator + (const double d, const Real & r)
 {
@@ -3104,6 +3591,167 @@ Real operator / (const double d, const Real & r)
 	mpfr_d_div(result.value, d, r.value, MPFR_RNDN);
 	return result;
 }
+
+Float operator + (const double d, const Float & f)
+{
+	return Float(d) + f;
+}
+
+Float operator - (const double d, const Float & f)
+{
+	return Float(d) - f;
+}
+
+Float operator * (const double d, const Float & f)
+{
+	return Float(d) * f;
+}
+
+Float operator / (const double d, const Float & f)
+{
+	return Float(d) / f;
+}
+
+#ifdef SIMD_DISPATCH
+// The vector loops are compiled for their instruction sets whatever the build flags, and sum_of_products
+// picks one by the processor it runs on. Each adds up the first products in blocks and returns their count.
+__attribute__((target("avx512f")))
+static unsigned int sum_of_products_avx512(double & lo, double & up, double & mag, const double *cl, const double *cu, const double *ml, const double *mu, const unsigned int n)
+{
+	__m512d vlo = _mm512_setzero_pd(), vup = _mm512_setzero_pd(), vmag = _mm512_setzero_pd();
+	unsigned int i = 0;
+
+	for(; i + 8 <= n; i += 8)
+	{
+		__m512d a = _mm512_loadu_pd(cl + i), b = _mm512_loadu_pd(cu + i);
+		__m512d c = _mm512_loadu_pd(ml + i), d = _mm512_loadu_pd(mu + i);
+
+		__m512d ac = _mm512_mul_pd(a, c), ad = _mm512_mul_pd(a, d);
+		__m512d bc = _mm512_mul_pd(b, c), bd = _mm512_mul_pd(b, d);
+
+		__m512d pmin = _mm512_min_pd(_mm512_min_pd(ac, ad), _mm512_min_pd(bc, bd));
+		__m512d pmax = _mm512_max_pd(_mm512_max_pd(ac, ad), _mm512_max_pd(bc, bd));
+
+		vlo = _mm512_add_pd(vlo, pmin);
+		vup = _mm512_add_pd(vup, pmax);
+		vmag = _mm512_add_pd(vmag, _mm512_max_pd(_mm512_sub_pd(_mm512_setzero_pd(), pmin), pmax));
+	}
+
+	double lanes[24];
+	_mm512_storeu_pd(lanes, vlo);
+	_mm512_storeu_pd(lanes + 8, vup);
+	_mm512_storeu_pd(lanes + 16, vmag);
+
+	lo = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+	up = ((lanes[8] + lanes[9]) + (lanes[10] + lanes[11])) + ((lanes[12] + lanes[13]) + (lanes[14] + lanes[15]));
+	mag = ((lanes[16] + lanes[17]) + (lanes[18] + lanes[19])) + ((lanes[20] + lanes[21]) + (lanes[22] + lanes[23]));
+
+	return i;
+}
+
+__attribute__((target("avx2")))
+static unsigned int sum_of_products_avx2(double & lo, double & up, double & mag, const double *cl, const double *cu, const double *ml, const double *mu, const unsigned int n)
+{
+	__m256d vlo = _mm256_setzero_pd(), vup = _mm256_setzero_pd(), vmag = _mm256_setzero_pd();
+	unsigned int i = 0;
+
+	for(; i + 4 <= n; i += 4)
+	{
+		__m256d a = _mm256_loadu_pd(cl + i), b = _mm256_loadu_pd(cu + i);
+		__m256d c = _mm256_loadu_pd(ml + i), d = _mm256_loadu_pd(mu + i);
+
+		__m256d ac = _mm256_mul_pd(a, c), ad = _mm256_mul_pd(a, d);
+		__m256d bc = _mm256_mul_pd(b, c), bd = _mm256_mul_pd(b, d);
+
+		__m256d pmin = _mm256_min_pd(_mm256_min_pd(ac, ad), _mm256_min_pd(bc, bd));
+		__m256d pmax = _mm256_max_pd(_mm256_max_pd(ac, ad), _mm256_max_pd(bc, bd));
+
+		vlo = _mm256_add_pd(vlo, pmin);
+		vup = _mm256_add_pd(vup, pmax);
+		vmag = _mm256_add_pd(vmag, _mm256_max_pd(_mm256_sub_pd(_mm256_setzero_pd(), pmin), pmax));
+	}
+
+	double lanes[12];
+	_mm256_storeu_pd(lanes, vlo);
+	_mm256_storeu_pd(lanes + 4, vup);
+	_mm256_storeu_pd(lanes + 8, vmag);
+
+	lo = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	up = (lanes[4] + lanes[5]) + (lanes[6] + lanes[7]);
+	mag = (lanes[8] + lanes[9]) + (lanes[10] + lanes[11]);
+
+	return i;
+}
+
+typedef unsigned int (*Sum_Of_Products_Kernel)(double &, double &, double &, const double *, const double *, const double *, const double *, const unsigned int);
+
+static Sum_Of_Products_Kernel select_sum_of_products()
+{
+	__builtin_cpu_init();
+
+	if(__builtin_cpu_supports("avx512f"))
+	{
+		return sum_of_products_avx512;
+	}
+	else if(__builtin_cpu_supports("avx2"))
+	{
+		return sum_of_products_avx2;
+	}
+	else
+	{
+		return NULL;
+	}
+}
+#endif
+
+/*
+ * The product of two intervals is the hull of the four products of their bounds. Every computed product,
+ * and the sum of n of them in any order, has an error less than gamma_n = n*u/(1 - n*u) times the sum of
+ * the magnitudes, where u is the unit roundoff, plus n times the smallest subnormal for the underflows.
+ * The bound below doubles it to also cover the rounding of the magnitudes and of the bound itself.
+ */
+bool sum_of_products(Interval & result, const double *cl, const double *cu, const double *ml, const double *mu, const unsigned int n)
+{
+	double lo = 0, up = 0, mag = 0;
+	unsigned int i = 0;
+
+#ifdef SIMD_DISPATCH
+	static const Sum_Of_Products_Kernel kernel = select_sum_of_products();
+
+	if(kernel != NULL)
+	{
+		i = kernel(lo, up, mag, cl, cu, ml, mu, n);
+	}
+#endif
+
+	for(; i < n; ++i)
+	{
+		double ac = cl[i] * ml[i], ad = cl[i] * mu[i];
+		double bc = cu[i] * ml[i], bd = cu[i] * mu[i];
+
+		double pmin = std::min(std::min(ac, ad), std::min(bc, bd));
+		double pmax = std::max(std::max(ac, ad), std::max(bc, bd));
+
+		lo += pmin;
+		up += pmax;
+		mag += std::max(-pmin, pmax);
+	}
+
+	double err = 2 * (n + 2) * (DBL_EPSILON / 2) * mag + (n + 1) * std::numeric_limits<double>::denorm_min();
+
+	lo = std::nextafter(lo - err, -std::numeric_limits<double>::infinity());
+	up = std::nextafter(up + err, std::numeric_limits<double>::infinity());
+
+	if(!std::isfinite(lo) || !std::isfinite(up))
+	{
+		return false;
+	}
+
+	Interval I(lo, up);
+	result = I;
+
+	return true;
+}
 /*
 Interval operator + (const double d, const Interval & I)
 {
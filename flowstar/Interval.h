@@ -12,6 +12,10 @@
 #include "include.h"
 
 extern mpfr_prec_t intervalNumPrecision;
+extern bool roundingErrorSweep;		// compute the flowpipes with Float coefficients, sweeping their rounding errors into the remainders
+
+#define INLINE_PRECISION	128		// the significand of a number of at most this precision is kept in the object
+#define INLINE_LIMBS		((INLINE_PRECISION + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS)
 
 namespace flowstar
 {
@@ -22,6 +26,7 @@ class Real
 {
 protected:
 	mpfr_t value;
+	mp_limb_t limbs[INLINE_LIMBS];		// the significand of value if it fits, otherwise it is on the heap
 public:
 	Real();
 	Real(const double d);
@@ -160,6 +165,7 @@ class Interval
 protected:
 	mpfr_t lo;		// the lower bound
 	mpfr_t up;		// the upper bound
+	mp_limb_t limbs[2*INLINE_LIMBS];	// the significands of lo and up if they fit
 
 public:
 	Interval();
@@ -331,8 +337,99 @@ public:
 };
 
 
+
+// A double coefficient with a bound of its rounding errors, the exact number is in [value - err, value + err].
+// Every operation is rounded to nearest, its rounding error is computed by an error-free transformation and
+// added to the bound rounded upward, so the arithmetic is rigorous without changing the rounding mode.
+// The bound is infinite if the value overflows.
+class Float
+{
+protected:
+	double value;
+	double err;
+
+public:
+	Float();
+	Float(const double d);
+	Float(const Real & r);
+	explicit Float(const Interval & I);		// the midpoint with the radius as the error
+	Float(const Float & f);
+	~Float();
+
+	void set(const double c);
+	bool isZero() const;					// zero without an error
+	bool belongsTo(const Interval & I) const;
+
+	double error() const;
+	double take_error();					// returns the error and resets it to zero
+
+	double getValue_RNDD() const;
+	double getValue_RNDU() const;
+	void mag(Real & r) const;
+	double mag() const;
+	double abs() const;
+	void abs_assign();
+
+	void to_sym_int(Interval & I) const;
+
+	void pow_assign(const int n);
+	void rec_assign();
+
+	void sin_assign();
+	void cos_assign();
+	void exp_assign();
+	void log_assign();
+	void sqrt_assign();
+
+	void sin(Float & c) const;
+	void cos(Float & c) const;
+	void exp(Float & c) const;
+	void log(Float & c) const;
+	void sqrt(Float & c) const;
+
+	void output(FILE *fp) const;
+	void dump(FILE *fp) const;
+
+	double toDouble() const;
+	Real toReal() const;					// the value without the error
+	std::string toString() const;
+
+	operator Interval () const;
+
+	Interval operator * (const Interval & I) const;
+
+	Float & operator += (const Float & f);
+	Float & operator -= (const Float & f);
+	Float & operator *= (const Float & f);
+	Float & operator /= (const Float & f);
+
+	Float operator - () const;
+	Float operator + (const Float & f) const;
+	Float operator - (const Float & f) const;
+	Float operator * (const Float & f) const;
+	Float operator / (const Float & f) const;
+
+	bool operator == (const Float & f) const;
+	bool operator != (const Float & f) const;
+
+	bool operator == (const double c) const;
+	bool operator != (const double c) const;
+
+	Float & operator = (const Float & f);
+	Float & operator = (const double c);
+
+	friend std::ostream & operator << (std::ostream & output, const Float & f);
+
+	friend Float operator + (const double d, const Float & f);
+	friend Float operator - (const double d, const Float & f);
+	friend Float operator * (const double d, const Float & f);
+	friend Float operator / (const double d, const Float & f);
+};
+
+
 std::ostream & operator << (std::ostream & output, const Real & r);
 std::ostream & operator << (std::ostream & output, const Interval & I);
+std::ostream & operator << (std::ostream & output, const Float & f);
 
 
 
@@ -341,6 +438,52 @@ Real operator - (const double d, const Real & r);
 Real operator * (const double d, const Real & r);
 Real operator / (const double d, const Real & r);
 
+Float operator + (const double d, const Float & f);
+Float operator - (const double d, const Float & f);
+Float operator * (const double d, const Float & f);
+Float operator / (const double d, const Float & f);
+
+
+// the bounds of a number in double precision, rounded outward
+inline void double_bounds(double & lo, double & up, const Real & r)
+{
+	lo = r.getValue_RNDD();
+	up = r.getValue_RNDU();
+}
+
+inline void double_bounds(double & lo, double & up, const Interval & I)
+{
+	lo = I.inf();
+	up = I.sup();
+}
+
+inline void double_bounds(double & lo, double & up, const Float & f)
+{
+	lo = f.getValue_RNDD();
+	up = f.getValue_RNDU();
+}
+
+// the rounding error of a coefficient, which is reset to zero, only Float coefficients have one
+inline double take_error(Real & r)
+{
+	return 0;
+}
+
+inline double take_error(Interval & I)
+{
+	return 0;
+}
+
+inline double take_error(Float & f)
+{
+	return f.take_error();
+}
+
+// Encloses the sum of the products [cl[i],cu[i]] * [ml[i],mu[i]], i = 0, ..., n-1, of finite double intervals.
+// The sum is computed in round-to-nearest and widened by a bound on its rounding error, so the result is safe
+// without changing the rounding mode. It returns false if the sum overflows.
+bool sum_of_products(Interval & result, const double *cl, const double *cu, const double *ml, const double *mu, const unsigned int n);
+
 }
 
 #endif /* INTERVAL_H_ */
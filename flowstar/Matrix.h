@@ -157,6 +157,7 @@ public:
 
 	friend Matrix<Interval> operator * (const Matrix<Real> & A, const Matrix<Interval> & B);
 	friend Matrix<Interval> operator * (const Matrix<Real> & A, const Matrix<Interval> & B);
+	friend Matrix<Interval> operator * (const Matrix<Float> & A, const Matrix<Interval> & B);
 
 //	template <class DATA_TYPE1, class DATA_TYPE2>
 //	friend Matrix<DATA_TYPE2> operator * (const Matrix<DATA_TYPE1> & A, const Matrix<DATA_TYPE2> & B);
@@ -1232,6 +1233,34 @@ inline Matrix<Interval> operator * (const Matrix<Real> & A, const Matrix<Interva
 	return result;
 }
 
+inline Matrix<Interval> operator * (const Matrix<Float> & A, const Matrix<Interval> & B)
+{
+	if(A.size2 != B.size1)
+	{
+		printf("Matrix Multiplication: Dimensions do not match.\n");
+		exit(1);
+	}
+
+	Matrix<Interval> result(A.size1, B.size2);
+
+	for(unsigned int i=0, pos1=0, pos2=0; i<A.size1; ++i, pos1+=A.size2, pos2+=B.size2)
+	{
+		for(unsigned int j=0; j<B.size2; ++j)
+		{
+			Interval tmp;
+
+			for(unsigned int k=0, pos3=0; k<A.size2; ++k, pos3+=B.size2)
+			{
+				tmp += Interval(A.data[pos1 + k]) * B.data[pos3 + j];
+			}
+
+			result.data[pos2 + j] = tmp;
+		}
+	}
+
+	return result;
+}
+
 /*
 template <class DATA_TYPE1, class DATA_TYPE2>
 Matrix<DATA_TYPE2> operator * (const Matrix<DATA_TYPE1> & A, const Matrix<DATA_TYPE2> & B)
@@ -18,6 +18,9 @@ extern Variables tmVars;
 namespace flowstar
 {
 
+// the terms of a polynomial are kept in the blocks of the thread pool
+template <class DATA_TYPE>
+using Term_List = std::list<Term<DATA_TYPE>, Pool_Allocator<Term<DATA_TYPE> > >;
 
 template <class DATA_TYPE>
 class Matrix;
@@ -29,7 +32,7 @@ template <class DATA_TYPE>
 class Polynomial														// polynomials in monomial form
 {
 protected:
-	std::list<Term<DATA_TYPE> > terms;
+	Term_List<DATA_TYPE> terms;
 
 public:
 	Polynomial();														// empty polynomial
@@ -38,12 +41,13 @@ public:
 	Polynomial(const std::vector<DATA_TYPE> & coefficients);			// linear polynomial with the given coefficients, the input matrix is a row vector
 	Polynomial(const DATA_TYPE *pCoefficients, const unsigned int numVars);
 	Polynomial(const Term<DATA_TYPE> & term);
-	Polynomial(const std::list<Term<DATA_TYPE> > & term_list);
+	Polynomial(const Term_List<DATA_TYPE> & term_list);
 	Polynomial(const unsigned int varID, const unsigned int degree, const unsigned int numVars);
 
 //	Polynomial(const UnivariatePolynomial & up, const int numVars);
 
 	Polynomial(const Polynomial<DATA_TYPE> & polynomial);
+	Polynomial(Polynomial<DATA_TYPE> && polynomial) noexcept;
 
 	~Polynomial();
 
@@ -52,7 +56,8 @@ public:
 	void reorder();														// sort the terms.
 	void clear();
 
-	void toReal(Polynomial<Real> & realPoly);
+	void toReal(Polynomial<Real> & realPoly) const;
+	void toFloat(Polynomial<Float> & floatPoly) const;
 	Polynomial(const std::string & strPolynomial);
 
 	void toString(std::string & result, const Variables & vars) const;
@@ -84,6 +89,7 @@ public:
 	void mul(Polynomial<DATA_TYPE> result, const unsigned int varIndex, const unsigned int degree) const;
 
 	Polynomial<DATA_TYPE> & operator = (const Polynomial<DATA_TYPE> & polynomial);
+	Polynomial<DATA_TYPE> & operator = (Polynomial<DATA_TYPE> && polynomial) noexcept;
 	Polynomial<DATA_TYPE> & operator = (const Term<DATA_TYPE> & term);
 
 	Polynomial<DATA_TYPE> & operator += (const Polynomial<DATA_TYPE> & polynomial);
@@ -115,6 +121,7 @@ public:
 	void ctrunc_normal(Interval & remainder, const std::vector<DATA_TYPE2> & step_exp_table, const unsigned int order);
 
 	void nctrunc(const unsigned int order);
+	void homogeneous(Polynomial<DATA_TYPE> & result, const unsigned int degree) const;	// the terms of the given degree
 
 	void linearCoefficients(Matrix<DATA_TYPE> & coefficients, const unsigned int row) const;
 	void linearCoefficients(std::vector<DATA_TYPE> & coefficients) const;
@@ -141,6 +148,10 @@ public:
 
 	void cutoff(const Interval & cutoff_threshold);
 
+	// move the rounding errors of the coefficients into intRem
+	template <class DATA_TYPE2>
+	void roundoff_normal(Interval & intRem, const std::vector<DATA_TYPE2> & step_exp_table);
+
 	void derivative(Polynomial<DATA_TYPE> & result, const unsigned int varIndex) const;						// derivative with respect to a variable
 	void LieDerivative(Polynomial<DATA_TYPE> & result, const std::vector<Polynomial<DATA_TYPE> > & f) const;	// Lie derivative without truncation
 
@@ -262,7 +273,7 @@ Polynomial<DATA_TYPE>::Polynomial(const Term<DATA_TYPE> & term)
 }
 
 template <class DATA_TYPE>
-Polynomial<DATA_TYPE>::Polynomial(const std::list<Term<DATA_TYPE> > & term_list)
+Polynomial<DATA_TYPE>::Polynomial(const Term_List<DATA_TYPE> & term_list)
 {
 	terms = term_list;
 }
@@ -282,6 +293,11 @@ Polynomial<DATA_TYPE>::Polynomial(const Polynomial<DATA_TYPE> & polynomial)
 	terms = polynomial.terms;
 }
 
+template <class DATA_TYPE>
+Polynomial<DATA_TYPE>::Polynomial(Polynomial<DATA_TYPE> && polynomial) noexcept : terms(std::move(polynomial.terms))
+{
+}
+
 template <class DATA_TYPE>
 Polynomial<DATA_TYPE>::~Polynomial()
 {
@@ -297,8 +313,8 @@ void Polynomial<DATA_TYPE>::toHornerForm(HornerForm<DATA_TYPE> & hf) const
 
 	unsigned int numVars = (terms.begin())->degrees.size();
 
-	std::list<Term<DATA_TYPE> > term_list = terms;
-	typename std::list<Term<DATA_TYPE> >::iterator iter = term_list.begin();
+	Term_List<DATA_TYPE> term_list = terms;
+	typename Term_List<DATA_TYPE>::iterator iter = term_list.begin();
 
 	if(iter->d == 0)
 	{
@@ -309,7 +325,7 @@ void Polynomial<DATA_TYPE>::toHornerForm(HornerForm<DATA_TYPE> & hf) const
 			return;
 	}
 
-	std::vector<std::list<Term<DATA_TYPE> > > term_list_table(numVars);
+	std::vector<Term_List<DATA_TYPE> > term_list_table(numVars);
 
 	for(iter = term_list.begin(); iter != term_list.end(); ++iter)
 	{
@@ -350,12 +366,12 @@ void Polynomial<DATA_TYPE>::clear()
 	terms.clear();
 }
 
-template <>
-inline void Polynomial<Interval>::toReal(Polynomial<Real> & realPoly)
+template <class DATA_TYPE>
+void Polynomial<DATA_TYPE>::toReal(Polynomial<Real> & realPoly) const
 {
 	realPoly.terms.clear();
 
-	std::list<Term<Interval> >::const_iterator iter;
+	typename Term_List<DATA_TYPE>::const_iterator iter;
 	for(iter = terms.begin(); iter != terms.end(); ++iter)
 	{
 		Term<Real> term;
@@ -367,6 +383,23 @@ inline void Polynomial<Interval>::toReal(Polynomial<Real> & realPoly)
 	}
 }
 
+template <class DATA_TYPE>
+void Polynomial<DATA_TYPE>::toFloat(Polynomial<Float> & floatPoly) const
+{
+	floatPoly.terms.clear();
+
+	typename Term_List<DATA_TYPE>::const_iterator iter;
+	for(iter = terms.begin(); iter != terms.end(); ++iter)
+	{
+		Term<Float> term;
+		term.coefficient = Float(iter->coefficient);
+		term.degrees = iter->degrees;
+		term.d = iter->d;
+
+		floatPoly.terms.push_back(term);
+	}
+}
+
 template <>
 inline Polynomial<Interval>::Polynomial(const std::string & strPolynomial)
 {
@@ -408,7 +441,7 @@ void Polynomial<DATA_TYPE>::toString(std::string & result, const Variables & var
 	else
 	{
 		result.clear();
-		typename std::list<Term<DATA_TYPE> >::const_iterator iter = terms.begin(), iter_last = terms.end();
+		typename Term_List<DATA_TYPE>::const_iterator iter = terms.begin(), iter_last = terms.end();
 
 		--iter_last;
 
@@ -434,7 +467,7 @@ void Polynomial<DATA_TYPE>::output(std::ostream & os, const Variables & vars) co
 		return;
 	}
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iter = terms.begin(), iter_last = terms.end();
+	typename Term_List<DATA_TYPE>::const_iterator iter = terms.begin(), iter_last = terms.end();
 
 	--iter_last;
 
@@ -456,7 +489,7 @@ void Polynomial<DATA_TYPE>::output_constraint(std::ostream & os, const Variables
 		return;
 	}
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iter = terms.begin(), iter_last = terms.end();
+	typename Term_List<DATA_TYPE>::const_iterator iter = terms.begin(), iter_last = terms.end();
 
 	--iter_last;
 
@@ -501,7 +534,7 @@ void Polynomial<DATA_TYPE>::evaluate_time(Polynomial<DATA_TYPE> & result, const
 	if(terms.size() == 0)
 		return;
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iter;
+	typename Term_List<DATA_TYPE>::const_iterator iter;
 
 	if(step_exp_table[1] == 0 || step_exp_table.size() == 0)		// t = 0
 	{
@@ -536,9 +569,32 @@ template <class DATA_TYPE>
 template <class DATA_TYPE2>
 void Polynomial<DATA_TYPE>::intEvalNormal(Interval & result, const std::vector<DATA_TYPE2> & step_exp_table) const
 {
-	result = 0;
+	typename Term_List<DATA_TYPE>::const_iterator iter;
+
+	// in double precision the terms are summed by the vectorized kernel, a higher precision is kept in MPFR
+	if(intervalNumPrecision <= normal_precision && terms.size() > 0)
+	{
+		static thread_local std::vector<double> bounds;
+
+		unsigned int n = terms.size();
+		bounds.resize(4*n);
+
+		double *cl = bounds.data(), *cu = cl + n, *ml = cu + n, *mu = ml + n;
+		bool bFinite = true;
+		unsigned int i = 0;
+
+		for(iter = terms.begin(); iter != terms.end() && bFinite; ++iter, ++i)
+		{
+			bFinite = iter->boundsNormal(cl[i], cu[i], ml[i], mu[i], step_exp_table);
+		}
+
+		if(bFinite && sum_of_products(result, cl, cu, ml, mu, n))
+		{
+			return;
+		}
+	}
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iter;
+	result = 0;
 
 	for(iter = terms.begin(); iter != terms.end(); ++iter)
 	{
@@ -592,7 +648,7 @@ void Polynomial<DATA_TYPE>::pow_assign(const unsigned int degree)
 		}
 	}
 
-	*this = result;
+	*this = std::move(result);
 }
 
 template <class DATA_TYPE>
@@ -648,13 +704,13 @@ void Polynomial<DATA_TYPE>::pow_assign(const unsigned int degree, const unsigned
 		}
 	}
 
-	*this = result;
+	*this = std::move(result);
 }
 
 template <class DATA_TYPE>
 void Polynomial<DATA_TYPE>::mul_assign(const unsigned int varIndex, const unsigned int degree)
 {
-	typename std::list<Term<DATA_TYPE> >::iterator iter;
+	typename Term_List<DATA_TYPE>::iterator iter;
 
 	for(iter = terms.begin(); iter != terms.end(); ++iter)
 	{
@@ -680,6 +736,13 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator = (const Polynomial<DATA
 	return *this;
 }
 
+template <class DATA_TYPE>
+Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator = (Polynomial<DATA_TYPE> && polynomial) noexcept
+{
+	terms.swap(polynomial.terms);
+	return *this;
+}
+
 template <class DATA_TYPE>
 Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator = (const Term<DATA_TYPE> & term)
 {
@@ -694,8 +757,8 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator += (const Polynomial<DAT
 {
 	Polynomial<DATA_TYPE> result;
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterA;			// polynomial A
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterB;			// polynomial B
+	typename Term_List<DATA_TYPE>::const_iterator iterA;			// polynomial A
+	typename Term_List<DATA_TYPE>::const_iterator iterB;			// polynomial B
 
 	for(iterA = terms.begin(), iterB = polynomial.terms.begin(); ; )
 	{
@@ -740,7 +803,7 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator += (const Polynomial<DAT
 			result.terms.push_back(*iterA);
 	}
 
-	*this = result;
+	*this = std::move(result);
 	return *this;
 }
 
@@ -752,7 +815,7 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator += (const Term<DATA_TYPE
 		return *this;
 	}
 
-	typename std::list<Term<DATA_TYPE> >::iterator iter;
+	typename Term_List<DATA_TYPE>::iterator iter;
 	bool bAdded = false;
 
 	for(iter = terms.begin(); iter != terms.end(); ++iter)
@@ -790,8 +853,8 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator -= (const Polynomial<DAT
 {
 	Polynomial<DATA_TYPE> result;
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterA;			// polynomial A
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterB;			// polynomial B
+	typename Term_List<DATA_TYPE>::const_iterator iterA;			// polynomial A
+	typename Term_List<DATA_TYPE>::const_iterator iterB;			// polynomial B
 
 	for(iterA = terms.begin(), iterB = polynomial.terms.begin(); ; )
 	{
@@ -836,7 +899,7 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator -= (const Polynomial<DAT
 			result.terms.push_back(*iterA);
 	}
 
-	*this = result;
+	*this = std::move(result);
 	return *this;
 }
 
@@ -848,7 +911,7 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator -= (const Term<DATA_TYPE
 		return *this;
 	}
 
-	typename std::list<Term<DATA_TYPE> >::iterator iter;
+	typename Term_List<DATA_TYPE>::iterator iter;
 	bool bAdded = false;
 
 	for(iter = terms.begin(); iter != terms.end(); ++iter)
@@ -892,7 +955,7 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator *= (const Polynomial<DAT
 		return *this;
 	}
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterB;
+	typename Term_List<DATA_TYPE>::const_iterator iterB;
 
 	for(iterB = polynomial.terms.begin(); iterB != polynomial.terms.end(); ++iterB)
 	{
@@ -901,7 +964,7 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator *= (const Polynomial<DAT
 		result += tmp;
 	}
 
-	*this = result;
+	*this = std::move(result);
 	return *this;
 }
 
@@ -914,7 +977,7 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator *= (const Term<DATA_TYPE
 	}
 	else
 	{
-		typename std::list<Term<DATA_TYPE> >::iterator iter;
+		typename Term_List<DATA_TYPE>::iterator iter;
 		for(iter = terms.begin(); iter != terms.end(); ++iter)
 		{
 			(*iter) *= term;
@@ -933,7 +996,7 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator *= (const DATA_TYPE & c)
 	}
 	else
 	{
-		typename std::list<Term<DATA_TYPE> >::iterator iter;
+		typename Term_List<DATA_TYPE>::iterator iter;
 		for(iter = terms.begin(); iter != terms.end(); ++iter)
 		{
 			iter->coefficient *= c;
@@ -946,7 +1009,7 @@ Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator *= (const DATA_TYPE & c)
 template <class DATA_TYPE>
 Polynomial<DATA_TYPE> & Polynomial<DATA_TYPE>::operator /= (const DATA_TYPE & c)
 {
-	typename std::list<Term<DATA_TYPE> >::iterator iter;
+	typename Term_List<DATA_TYPE>::iterator iter;
 	for(iter = terms.begin(); iter != terms.end(); ++iter)
 	{
 		iter->coefficient /= c;
@@ -960,8 +1023,8 @@ Polynomial<DATA_TYPE> Polynomial<DATA_TYPE>::operator + (const Polynomial<DATA_T
 {
 	Polynomial<DATA_TYPE> result;
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterA;			// polynomial A
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterB;			// polynomial B
+	typename Term_List<DATA_TYPE>::const_iterator iterA;			// polynomial A
+	typename Term_List<DATA_TYPE>::const_iterator iterB;			// polynomial B
 
 	for(iterA = terms.begin(), iterB = polynomial.terms.begin(); ; )
 	{
@@ -1022,8 +1085,8 @@ Polynomial<DATA_TYPE> Polynomial<DATA_TYPE>::operator - (const Polynomial<DATA_T
 {
 	Polynomial<DATA_TYPE> result;
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterA;			// polynomial A
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterB;			// polynomial B
+	typename Term_List<DATA_TYPE>::const_iterator iterA;			// polynomial A
+	typename Term_List<DATA_TYPE>::const_iterator iterB;			// polynomial B
 
 	for(iterA = terms.begin(), iterB = polynomial.terms.begin(); ; )
 	{
@@ -1089,7 +1152,7 @@ Polynomial<DATA_TYPE> Polynomial<DATA_TYPE>::operator * (const Polynomial<DATA_T
 		return result;
 	}
 
-	typename std::list<Term<DATA_TYPE> >::const_iterator iterB;
+	typename Term_List<DATA_TYPE>::const_iterator iterB;
 
 	for(iterB = polynomial.terms.begin(); iterB != polynomial.terms.end(); ++iterB)
 	{
@@ -1207,10 +1270,26 @@ void Polynomial<DATA_TYPE>::nctrunc(const unsigned int order)
 	}
 }
 
+template <class DATA_TYPE>
+void Polynomial<DATA_TYPE>::homogeneous(Polynomial<DATA_TYPE> & result, const unsigned int degree) const
+{
+	result.terms.clear();
+
+	typename Term_List<DATA_TYPE>::const_iterator iter = terms.begin();
+
+	for(; iter != terms.end() && iter->d <= degree; ++iter)
+	{
+		if(iter->d == degree)
+		{
+			result.terms.push_back(*iter);
+		}
+	}
+}
+
 template <class DATA_TYPE>
 void Polynomial<DATA_TYPE>::linearCoefficients(Matrix<DATA_TYPE> & coefficients, const unsigned int row) const
 {
-	typename std::list<Term<DATA_TYPE> >::const_iterator iter;
+	typename Term_List<DATA_TYPE>::const_iterator iter;
 
 	for(iter = terms.begin(); iter != terms.end(); ++iter)
 	{
@@ -1232,7 +1311,7 @@ void Polynomial<DATA_TYPE>::linearCoefficients(Matrix<DATA_TYPE> & coefficients,
 template <class DATA_TYPE>
 void Polynomial<DATA_TYPE>::linearCoefficients(std::vector<DATA_TYPE> & coefficients) const
 {
-	typename std::list<Term<DATA_TYPE> >::const_iterator iter;
+	typename Term_List<DATA_TYPE>::const_iterator iter;
 
 	for(iter = terms.begin(); iter != terms.end(); ++iter)
 	{
@@ -1263,7 +1342,7 @@ void Polynomial<DATA_TYPE>::rmConstant()
 template <class DATA_TYPE>
 void Polynomial<DATA_TYPE>::decompose(Polynomial<DATA_TYPE> & linear, Polynomial<DATA_TYPE> & other) const
 {
-	typename std::list<Term<DATA_TYPE> >::const_iterator iter;
+	typename Term_List<DATA_TYPE>::const_iterator iter;
 
 	linear.terms.clear();
 	other.terms.clear();
@@ -1315,7 +1394,7 @@ void Polynomial<DATA_TYPE>::rmZeroTerms(const std::vector<unsigned int> & indice
 		return;
 	}
 
-	typename std::list<Term<DATA_TYPE> >::iterator iter = terms.begin();
+	typename Term_List<DATA_TYPE>::iterator iter = terms.begin();
 
 	for(; iter != terms.end();)
 	{
@@ -1341,7 +1420,7 @@ void Polynomial<DATA_TYPE>::rmZeroTerms(const std::vector<unsigned int> & indice
 template <class DATA_TYPE>
 void Polynomial<DATA_TYPE>::integral_time()
 {
-	typename std::list<Term<DATA_TYPE> >::iterator iter = terms.begin();
+	typename Term_List<DATA_TYPE>::iterator iter = terms.begin();
 
 	for(; iter != terms.end(); ++iter)
 	{
@@ -1365,7 +1444,7 @@ void Polynomial<DATA_TYPE>::cutoff_normal(Interval & intRem, const std::vector<D
 {
 	Polynomial<DATA_TYPE> polyTmp;
 
-	typename std::list<Term<DATA_TYPE> >::iterator iter;
+	typename Term_List<DATA_TYPE>::iterator iter;
 	for(iter = terms.begin(); iter != terms.end(); )
 	{
 		if(iter->coefficient.belongsTo(cutoff_threshold))
@@ -1388,7 +1467,7 @@ void Polynomial<DATA_TYPE>::cutoff(Interval & intRem, const std::vector<DATA_TYP
 {
 	Polynomial<DATA_TYPE> polyTmp;
 
-	typename std::list<Term<DATA_TYPE> >::iterator iter;
+	typename Term_List<DATA_TYPE>::iterator iter;
 	for(iter = terms.begin(); iter != terms.end(); )
 	{
 		if(iter->coefficient.belongsTo(cutoff_threshold))
@@ -1408,7 +1487,7 @@ void Polynomial<DATA_TYPE>::cutoff(Interval & intRem, const std::vector<DATA_TYP
 template <class DATA_TYPE>
 void Polynomial<DATA_TYPE>::cutoff(const Interval & cutoff_threshold)
 {
-	typename std::list<Term<DATA_TYPE> >::iterator iter;
+	typename Term_List<DATA_TYPE>::iterator iter;
 	for(iter = terms.begin(); iter != terms.end(); )
 	{
 		if(iter->coefficient.belongsTo(cutoff_threshold))
@@ -1422,12 +1501,41 @@ void Polynomial<DATA_TYPE>::cutoff(const Interval & cutoff_threshold)
 	}
 }
 
+template <class DATA_TYPE>
+template <class DATA_TYPE2>
+void Polynomial<DATA_TYPE>::roundoff_normal(Interval & intRem, const std::vector<DATA_TYPE2> & step_exp_table)
+{
+	intRem = 0;
+
+	typename Term_List<DATA_TYPE>::iterator iter;
+	for(iter = terms.begin(); iter != terms.end(); ++iter)
+	{
+		double e = take_error(iter->coefficient);
+
+		if(e > 0)
+		{
+			Term<Interval> term(Interval(-e, e));
+			term.degrees = iter->degrees;
+			term.d = iter->d;
+
+			Interval I(-e, e);
+
+			if(term.degrees.size() > 0)
+			{
+				term.intEvalNormal(I, step_exp_table);
+			}
+
+			intRem += I;
+		}
+	}
+}
+
 template <class DATA_TYPE>
 void Polynomial<DATA_TYPE>::derivative(Polynomial<DATA_TYPE> & result, const unsigned int varIndex) const
 {
 	result = *this;
 
-	typename std::list<Term<DATA_TYPE> >::iterator iter;
+	typename Term_List<DATA_TYPE>::iterator iter;
 
 	for(iter = result.terms.begin(); iter != result.terms.end(); )
 	{
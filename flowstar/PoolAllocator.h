@@ -0,0 +1,149 @@
+/*---
+  Email: Xin Chen <chenxin415@gmail.com> if you have questions or comments.
+  The code is released as is under the GNU General Public License (GPL).
+---*/
+
+#ifndef POOLALLOCATOR_H_
+#define POOLALLOCATOR_H_
+
+#include "include.h"
+
+#define POOL_GRANULE		16		// the sizes of the pooled blocks are multiples of it
+#define POOL_CLASSES		16		// blocks of at most POOL_GRANULE * POOL_CLASSES bytes are pooled
+#define POOL_MAX_BLOCKS		8192	// the most free blocks kept in a size class of a thread
+
+namespace flowstar
+{
+
+// The free small blocks of a thread, one list per size class. A block freed in the thread is handed out again by its
+// next allocation of that size class, so the terms created and destroyed in a flowpipe step do not go through malloc.
+// Every block is obtained from operator new on its own, hence it may be freed in any thread.
+class Block_Pool
+{
+protected:
+	struct Free_Block
+	{
+		Free_Block *next;
+	};
+
+	Free_Block *heads[POOL_CLASSES];
+	unsigned int counts[POOL_CLASSES];
+
+public:
+	Block_Pool()
+	{
+		for(unsigned int i=0; i<POOL_CLASSES; ++i)
+		{
+			heads[i] = NULL;
+			counts[i] = 0;
+		}
+	}
+
+	~Block_Pool()
+	{
+		for(unsigned int i=0; i<POOL_CLASSES; ++i)
+		{
+			while(heads[i] != NULL)
+			{
+				Free_Block *p = heads[i];
+				heads[i] = p->next;
+				::operator delete(p);
+			}
+
+			// the blocks freed by the destructors which run after this one go back to operator delete
+			counts[i] = POOL_MAX_BLOCKS;
+		}
+	}
+
+	void *allocate(const std::size_t size)
+	{
+		if(size > POOL_GRANULE * POOL_CLASSES)
+		{
+			return ::operator new(size);
+		}
+
+		unsigned int c = (size - 1) / POOL_GRANULE;
+		Free_Block *p = heads[c];
+
+		if(p == NULL)
+		{
+			return ::operator new((c + 1) * POOL_GRANULE);
+		}
+
+		heads[c] = p->next;
+		--counts[c];
+
+		return p;
+	}
+
+	void deallocate(void *ptr, const std::size_t size)
+	{
+		if(size > POOL_GRANULE * POOL_CLASSES)
+		{
+			::operator delete(ptr);
+			return;
+		}
+
+		unsigned int c = (size - 1) / POOL_GRANULE;
+
+		if(counts[c] >= POOL_MAX_BLOCKS)
+		{
+			::operator delete(ptr);
+			return;
+		}
+
+		Free_Block *p = static_cast<Free_Block *>(ptr);
+		p->next = heads[c];
+		heads[c] = p;
+		++counts[c];
+	}
+
+	static Block_Pool & local()
+	{
+		static thread_local Block_Pool pool;
+		return pool;
+	}
+};
+
+// An allocator for the containers of the Taylor model arithmetic, which takes the blocks from the pool of the thread.
+template <class T>
+class Pool_Allocator
+{
+public:
+	typedef T value_type;
+
+	Pool_Allocator()
+	{
+	}
+
+	template <class T2>
+	Pool_Allocator(const Pool_Allocator<T2> & allocator)
+	{
+	}
+
+	T *allocate(const std::size_t n)
+	{
+		return static_cast<T *>(Block_Pool::local().allocate(n * sizeof(T)));
+	}
+
+	void deallocate(T *p, const std::size_t n)
+	{
+		Block_Pool::local().deallocate(p, n * sizeof(T));
+	}
+};
+
+template <class T1, class T2>
+inline bool operator == (const Pool_Allocator<T1> & a, const Pool_Allocator<T2> & b)
+{
+	return true;
+}
+
+template <class T1, class T2>
+inline bool operator != (const Pool_Allocator<T1> & a, const Pool_Allocator<T2> & b)
+{
+	return false;
+}
+
+}
+
+#endif /* POOLALLOCATOR_H_ */
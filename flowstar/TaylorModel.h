@@ -190,6 +190,7 @@ public:
 
 	TaylorModel(const UnivariateTaylorModel<DATA_TYPE> & utm, const unsigned int numVars, const bool dummy);
 	TaylorModel(const TaylorModel<DATA_TYPE> & tm);
+	TaylorModel(TaylorModel<DATA_TYPE> && tm) noexcept;
 	~TaylorModel();
 
 //	TaylorModel(const std::string & strPolynomial, const Variables & vars);
@@ -215,6 +216,7 @@ public:
 	void ctrunc_normal(const std::vector<DATA_TYPE2> & step_exp_table, const unsigned int order);
 
 	TaylorModel<DATA_TYPE> & operator = (const TaylorModel<DATA_TYPE> & tm);
+	TaylorModel<DATA_TYPE> & operator = (TaylorModel<DATA_TYPE> && tm) noexcept;
 	TaylorModel<DATA_TYPE> & operator = (const Polynomial<DATA_TYPE> & p);
 
 	TaylorModel<DATA_TYPE> & operator += (const TaylorModel<DATA_TYPE> & tm);
@@ -311,6 +313,10 @@ public:
 	template <class DATA_TYPE2, class DATA_TYPE3>
 	void insert_ctrunc_normal(TaylorModel<DATA_TYPE> & result, const TaylorModelVec<DATA_TYPE> & vars, const std::vector<DATA_TYPE2> & varsPolyRange, const std::vector<DATA_TYPE3> & step_exp_table, const unsigned int numVars, const unsigned int order, const Interval & cutoff_threshold) const;
 
+	// the terms sharing a product of the variables are composed together, and the products are kept in products for the other compositions with the same variables
+	template <class DATA_TYPE2, class DATA_TYPE3>
+	void insert_ctrunc_normal(TaylorModel<DATA_TYPE> & result, const TaylorModelVec<DATA_TYPE> & vars, const std::vector<DATA_TYPE2> & varsPolyRange, const std::vector<DATA_TYPE3> & step_exp_table, const unsigned int numVars, const unsigned int order, const Interval & cutoff_threshold, std::map<std::vector<unsigned int>, TaylorModel<DATA_TYPE> > & products) const;
+
 //	void insert_ctrunc_normal_no_cutoff(TaylorModel & result, const TaylorModelVec & vars, const std::vector<Interval> & varsPolyRange, const std::vector<Interval> & step_exp_table, const int numVars, const int order) const;
 
 	template <class DATA_TYPE2>
@@ -525,6 +531,11 @@ TaylorModel<DATA_TYPE>::TaylorModel(const TaylorModel<DATA_TYPE> & tm)
 	remainder = tm.remainder;
 }
 
+template <class DATA_TYPE>
+TaylorModel<DATA_TYPE>::TaylorModel(TaylorModel<DATA_TYPE> && tm) noexcept : expansion(std::move(tm.expansion)), remainder(tm.remainder)
+{
+}
+
 template <class DATA_TYPE>
 TaylorModel<DATA_TYPE>::~TaylorModel()
 {
@@ -602,6 +613,15 @@ TaylorModel<DATA_TYPE> & TaylorModel<DATA_TYPE>::operator = (const TaylorModel<D
 	return *this;
 }
 
+template <class DATA_TYPE>
+TaylorModel<DATA_TYPE> & TaylorModel<DATA_TYPE>::operator = (TaylorModel<DATA_TYPE> && tm) noexcept
+{
+	expansion = std::move(tm.expansion);
+	remainder = tm.remainder;
+
+	return *this;
+}
+
 template <class DATA_TYPE>
 TaylorModel<DATA_TYPE> & TaylorModel<DATA_TYPE>::operator = (const Polynomial<DATA_TYPE> & p)
 {
@@ -974,7 +994,7 @@ void TaylorModel<DATA_TYPE>::mul_insert_ctrunc_assign(const TaylorModel<DATA_TYP
 {
 	TaylorModel<DATA_TYPE> result;
 	mul_insert_ctrunc(result, tm, tmPolyRange, domain, order, cutoff_threshold);
-	*this = result;
+	*this = std::move(result);
 }
 
 template <class DATA_TYPE>
@@ -983,7 +1003,7 @@ void TaylorModel<DATA_TYPE>::mul_insert_ctrunc_normal_assign(const TaylorModel<D
 {
 	TaylorModel<DATA_TYPE> result;
 	mul_insert_ctrunc_normal(result, tm, tmPolyRange, step_exp_table, order, cutoff_threshold);
-	*this = result;
+	*this = std::move(result);
 }
 
 template <class DATA_TYPE>
@@ -992,7 +1012,7 @@ void TaylorModel<DATA_TYPE>::mul_insert_ctrunc_normal_assign(Interval & tm1, Int
 {
 	TaylorModel<DATA_TYPE> result;
 	mul_insert_ctrunc_normal(result, tm1, intTrunc, tm, tmPolyRange, step_exp_table, order, cutoff_threshold);
-	*this = result;
+	*this = std::move(result);
 }
 
 template <class DATA_TYPE>
@@ -1054,7 +1074,7 @@ void TaylorModel<DATA_TYPE>::insert_ctrunc(TaylorModel<DATA_TYPE> & result, cons
 	{
 		result = *this;
 
-		typename std::list<Term<DATA_TYPE> >::iterator iter;
+		typename Term_List<DATA_TYPE>::iterator iter;
 
 		for(iter = result.expansion.terms.begin(); iter != result.expansion.terms.end(); )
 		{
@@ -1085,7 +1105,7 @@ void TaylorModel<DATA_TYPE>::insert_no_remainder(TaylorModel<DATA_TYPE> & result
 	{
 		result = *this;
 
-		typename std::list<Term<DATA_TYPE> >::iterator iter;
+		typename Term_List<DATA_TYPE>::iterator iter;
 
 		for(iter = result.expansion.terms.begin(); iter != result.expansion.terms.end();)
 		{
@@ -1116,7 +1136,7 @@ void TaylorModel<DATA_TYPE>::insert_ctrunc_normal(TaylorModel<DATA_TYPE> & resul
 	{
 		result = *this;
 
-		typename std::list<Term<DATA_TYPE> >::iterator iter;
+		typename Term_List<DATA_TYPE>::iterator iter;
 
 		for(iter = result.expansion.terms.begin(); iter != result.expansion.terms.end(); )
 		{
@@ -1140,6 +1160,97 @@ void TaylorModel<DATA_TYPE>::insert_ctrunc_normal(TaylorModel<DATA_TYPE> & resul
 	}
 }
 
+// The product of the variables with the exponents key[1], key[2], ... truncated at the order key[0].
+// It is computed from the product with one less factor, so every product costs one multiplication.
+template <class DATA_TYPE, class DATA_TYPE2, class DATA_TYPE3>
+const TaylorModel<DATA_TYPE> & vars_product(std::map<std::vector<unsigned int>, TaylorModel<DATA_TYPE> > & products, const std::vector<unsigned int> & key, const TaylorModelVec<DATA_TYPE> & vars, const std::vector<DATA_TYPE2> & varsPolyRange, const std::vector<DATA_TYPE3> & step_exp_table, const unsigned int numVars, const Interval & cutoff_threshold)
+{
+	typename std::map<std::vector<unsigned int>, TaylorModel<DATA_TYPE> >::const_iterator iter = products.find(key);
+
+	if(iter != products.end())
+	{
+		return iter->second;
+	}
+
+	unsigned int j = 1;
+
+	while(j < key.size() && key[j] == 0)
+	{
+		++j;
+	}
+
+	TaylorModel<DATA_TYPE> product;
+
+	if(j == key.size())
+	{
+		TaylorModel<DATA_TYPE> tmOne(DATA_TYPE(1), numVars);
+		product = tmOne;
+	}
+	else
+	{
+		std::vector<unsigned int> parent = key;
+		parent[j] -= 1;
+
+		vars_product(products, parent, vars, varsPolyRange, step_exp_table, numVars, cutoff_threshold).mul_insert_ctrunc_normal(product, vars.tms[j-1], varsPolyRange[j-1], step_exp_table, key[0], cutoff_threshold);
+	}
+
+	return products[key] = product;
+}
+
+template <class DATA_TYPE>
+template <class DATA_TYPE2, class DATA_TYPE3>
+void TaylorModel<DATA_TYPE>::insert_ctrunc_normal(TaylorModel<DATA_TYPE> & result, const TaylorModelVec<DATA_TYPE> & vars, const std::vector<DATA_TYPE2> & varsPolyRange, const std::vector<DATA_TYPE3> & step_exp_table, const unsigned int numVars, const unsigned int order, const Interval & cutoff_threshold, std::map<std::vector<unsigned int>, TaylorModel<DATA_TYPE> > & products) const
+{
+	if(vars.tms.size() == 0)
+	{
+		insert_ctrunc_normal(result, vars, varsPolyRange, step_exp_table, numVars, order, cutoff_threshold);
+		return;
+	}
+
+	// group the terms by their product of the variables, the rest of a group is a polynomial in t
+	std::map<std::vector<unsigned int>, Polynomial<DATA_TYPE> > groups;
+
+	typename Term_List<DATA_TYPE>::const_iterator iter = expansion.terms.begin();
+
+	for(; iter != expansion.terms.end(); ++iter)
+	{
+		std::vector<unsigned int> key(iter->degrees.begin(), iter->degrees.end());
+		key[0] = order;
+
+		Term<DATA_TYPE> term = *iter;
+
+		for(unsigned int j=1; j<term.degrees.size(); ++j)
+		{
+			term.degrees[j] = 0;
+		}
+
+		term.d = term.degrees[0];
+		groups[key] += term;
+	}
+
+	result.clear();
+
+	typename std::map<std::vector<unsigned int>, Polynomial<DATA_TYPE> >::const_iterator group = groups.begin();
+
+	for(; group != groups.end(); ++group)
+	{
+		const TaylorModel<DATA_TYPE> & product = vars_product(products, group->first, vars, varsPolyRange, step_exp_table, numVars, cutoff_threshold);
+
+		Interval timeRange;
+		group->second.intEvalNormal(timeRange, step_exp_table);
+
+		TaylorModel<DATA_TYPE> tmp;
+		tmp.expansion = product.expansion * group->second;
+		tmp.remainder = product.remainder * timeRange;
+
+		result += tmp;
+	}
+
+	result.ctrunc_normal(step_exp_table, order);
+	result.cutoff_normal(step_exp_table, cutoff_threshold);
+	result.remainder += remainder;
+}
+
 template <class DATA_TYPE>
 template <class DATA_TYPE2>
 void TaylorModel<DATA_TYPE>::evaluate_time(TaylorModel<DATA_TYPE> & result, const std::vector<DATA_TYPE2> & step_exp_table) const
@@ -1503,7 +1614,7 @@ void TaylorModel<DATA_TYPE>::sin_taylor(TaylorModel<DATA_TYPE> & result, std::li
 			ranges.push_back(tmFPolyRange);		// keep the unchanged part
 			ranges.push_back(intTrunc);			// keep the unchanged part
 
-			Real tmp = sinc / i;
+			DATA_TYPE tmp = sinc / i;
 			ranges.push_back(tmp);				// keep the unchanged part
 
 			tmPowerTmF *= tmp;
@@ -1520,7 +1631,7 @@ void TaylorModel<DATA_TYPE>::sin_taylor(TaylorModel<DATA_TYPE> & result, std::li
 			ranges.push_back(tmFPolyRange);		// keep the unchanged part
 			ranges.push_back(intTrunc);			// keep the unchanged part
 
-			Real tmp = cosc / i;
+			DATA_TYPE tmp = cosc / i;
 			ranges.push_back(tmp);				// keep the unchanged part
 
 			tmPowerTmF *= tmp;
@@ -1537,7 +1648,7 @@ void TaylorModel<DATA_TYPE>::sin_taylor(TaylorModel<DATA_TYPE> & result, std::li
 			ranges.push_back(tmFPolyRange);		// keep the unchanged part
 			ranges.push_back(intTrunc);			// keep the unchanged part
 
-			Real tmp = msinc / i;
+			DATA_TYPE tmp = msinc / i;
 			ranges.push_back(tmp);				// keep the unchanged part
 
 			tmPowerTmF *= tmp;
@@ -1554,7 +1665,7 @@ void TaylorModel<DATA_TYPE>::sin_taylor(TaylorModel<DATA_TYPE> & result, std::li
 			ranges.push_back(tmFPolyRange);		// keep the unchanged part
 			ranges.push_back(intTrunc);			// keep the unchanged part
 
-			Real tmp = mcosc / i;
+			DATA_TYPE tmp = mcosc / i;
 			ranges.push_back(tmp);				// keep the unchanged part
 
 			tmPowerTmF *= tmp;
@@ -1638,7 +1749,7 @@ void TaylorModel<DATA_TYPE>::cos_taylor(TaylorModel<DATA_TYPE> & result, std::li
 			ranges.push_back(tmFPolyRange);		// keep the unchanged part
 			ranges.push_back(intTrunc);			// keep the unchanged part
 
-			Real tmp = cosc / i;
+			DATA_TYPE tmp = cosc / i;
 			ranges.push_back(tmp);				// keep the unchanged part
 
 			tmPowerTmF *= tmp;
@@ -1655,7 +1766,7 @@ void TaylorModel<DATA_TYPE>::cos_taylor(TaylorModel<DATA_TYPE> & result, std::li
 			ranges.push_back(tmFPolyRange);		// keep the unchanged part
 			ranges.push_back(intTrunc);			// keep the unchanged part
 
-			Real tmp = msinc / i;
+			DATA_TYPE tmp = msinc / i;
 			ranges.push_back(tmp);				// keep the unchanged part
 
 			tmPowerTmF *= tmp;
@@ -1672,7 +1783,7 @@ void TaylorModel<DATA_TYPE>::cos_taylor(TaylorModel<DATA_TYPE> & result, std::li
 			ranges.push_back(tmFPolyRange);		// keep the unchanged part
 			ranges.push_back(intTrunc);			// keep the unchanged part
 
-			Real tmp = mcosc / i;
+			DATA_TYPE tmp = mcosc / i;
 			ranges.push_back(tmp);				// keep the unchanged part
 
 			tmPowerTmF *= tmp;
@@ -1689,7 +1800,7 @@ void TaylorModel<DATA_TYPE>::cos_taylor(TaylorModel<DATA_TYPE> & result, std::li
 			ranges.push_back(tmFPolyRange);		// keep the unchanged part
 			ranges.push_back(intTrunc);			// keep the unchanged part
 
-			Real tmp = sinc / i;
+			DATA_TYPE tmp = sinc / i;
 			ranges.push_back(tmp);				// keep the unchanged part
 
 			tmPowerTmF *= tmp;
@@ -2016,7 +2127,7 @@ void TaylorModel<DATA_TYPE>::sin_taylor(TaylorModel<DATA_TYPE> & result, const s
 		{
 			tmPowerTmF.mul_insert_ctrunc_assign(tmF, tmFPolyRange, domain, order, cutoff_threshold);
 
-			Real tmp = sinc / i;
+			DATA_TYPE tmp = sinc / i;
 
 			tmPowerTmF *= tmp;
 			result += tmPowerTmF;
@@ -2027,7 +2138,7 @@ void TaylorModel<DATA_TYPE>::sin_taylor(TaylorModel<DATA_TYPE> & result, const s
 		{
 			tmPowerTmF.mul_insert_ctrunc_assign(tmF, tmFPolyRange, domain, order, cutoff_threshold);
 
-			Real tmp = cosc / i;
+			DATA_TYPE tmp = cosc / i;
 
 			tmPowerTmF *= tmp;
 			result += tmPowerTmF;
@@ -2038,7 +2149,7 @@ void TaylorModel<DATA_TYPE>::sin_taylor(TaylorModel<DATA_TYPE> & result, const s
 		{
 			tmPowerTmF.mul_insert_ctrunc_assign(tmF, tmFPolyRange, domain, order, cutoff_threshold);
 
-			Real tmp = msinc / i;
+			DATA_TYPE tmp = msinc / i;
 
 			tmPowerTmF *= tmp;
 			result += tmPowerTmF;
@@ -2049,7 +2160,7 @@ void TaylorModel<DATA_TYPE>::sin_taylor(TaylorModel<DATA_TYPE> & result, const s
 		{
 			tmPowerTmF.mul_insert_ctrunc_assign(tmF, tmFPolyRange, domain, order, cutoff_threshold);
 
-			Real tmp = mcosc / i;
+			DATA_TYPE tmp = mcosc / i;
 
 			tmPowerTmF *= tmp;
 			result += tmPowerTmF;
@@ -2120,7 +2231,7 @@ void TaylorModel<DATA_TYPE>::cos_taylor(TaylorModel<DATA_TYPE> & result, const s
 		{
 			tmPowerTmF.mul_insert_ctrunc_assign(tmF, tmFPolyRange, domain, order, cutoff_threshold);
 
-			Real tmp = cosc / i;
+			DATA_TYPE tmp = cosc / i;
 
 			tmPowerTmF *= tmp;
 			result += tmPowerTmF;
@@ -2131,7 +2242,7 @@ void TaylorModel<DATA_TYPE>::cos_taylor(TaylorModel<DATA_TYPE> & result, const s
 		{
 			tmPowerTmF.mul_insert_ctrunc_normal_assign(tmF, tmFPolyRange, domain, order, cutoff_threshold);
 
-			Real tmp = msinc / i;
+			DATA_TYPE tmp = msinc / i;
 
 			tmPowerTmF *= tmp;
 			result += tmPowerTmF;
@@ -2142,7 +2253,7 @@ void TaylorModel<DATA_TYPE>::cos_taylor(TaylorModel<DATA_TYPE> & result, const s
 		{
 			tmPowerTmF.mul_insert_ctrunc_normal_assign(tmF, tmFPolyRange, domain, order, cutoff_threshold);
 
-			Real tmp = mcosc / i;
+			DATA_TYPE tmp = mcosc / i;
 
 			tmPowerTmF *= tmp;
 			result += tmPowerTmF;
@@ -2153,7 +2264,7 @@ void TaylorModel<DATA_TYPE>::cos_taylor(TaylorModel<DATA_TYPE> & result, const s
 		{
 			tmPowerTmF.mul_insert_ctrunc_normal_assign(tmF, tmFPolyRange, domain, order, cutoff_threshold);
 
-			Real tmp = sinc / i;
+			DATA_TYPE tmp = sinc / i;
 
 			tmPowerTmF *= tmp;
 			result += tmPowerTmF;
@@ -2328,6 +2439,7 @@ public:
 
 	TaylorModelVec(const unsigned int dim);
 	TaylorModelVec(const TaylorModelVec<DATA_TYPE> & tmv);
+	TaylorModelVec(TaylorModelVec<DATA_TYPE> && tmv) noexcept;
 	~TaylorModelVec();
 
 	void clear();
@@ -2368,6 +2480,7 @@ public:
 
 
 	TaylorModelVec<DATA_TYPE> & operator = (const TaylorModelVec<DATA_TYPE> & tmv);
+	TaylorModelVec<DATA_TYPE> & operator = (TaylorModelVec<DATA_TYPE> && tmv) noexcept;
 	TaylorModelVec<DATA_TYPE> & operator = (const std::vector<Polynomial<DATA_TYPE> > & pv);
 
 	TaylorModelVec<DATA_TYPE> & operator += (const TaylorModelVec<DATA_TYPE> & tmv);
@@ -2445,6 +2558,13 @@ public:
 
 	void cutoff(const Interval & cutoff_threshold);
 
+	// move the rounding errors of the coefficients into the remainders, errors receives the moved amounts
+	template <class DATA_TYPE2>
+	void roundoff_normal(std::vector<Interval> & errors, const std::vector<DATA_TYPE2> & step_exp_table);
+
+	void toReal(TaylorModelVec<Real> & result) const;			// the values of the coefficients without their rounding errors
+	void toFloat(TaylorModelVec<Float> & result) const;
+
 	double rho(const std::vector<Real> & l, const std::vector<Interval> & domain) const;
 	double rho_normal(const std::vector<Real> & l, const std::vector<Interval> & step_exp_table) const;
 
@@ -2586,7 +2706,7 @@ TaylorModelVec<DATA_TYPE>::TaylorModelVec(const std::vector<DATA_TYPE> & constan
 	for(unsigned int i=0; i<constants.size(); ++i)
 	{
 		TaylorModel<DATA_TYPE> tmTemp(constants[i], numVars);
-		tms.push_back(tmTemp);
+		tms.push_back(std::move(tmTemp));
 	}
 }
 
@@ -2600,7 +2720,7 @@ TaylorModelVec<DATA_TYPE>::TaylorModelVec(Matrix<DATA_TYPE> & coefficients)
 	{
 		DATA_TYPE *p = coefficients.getRowVecRef(i);
 		TaylorModel<DATA_TYPE> tmTmp(p, cols);
-		tms.push_back(tmTmp);
+		tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -2612,7 +2732,7 @@ TaylorModelVec<DATA_TYPE>::TaylorModelVec(const std::vector<DATA_TYPE> & coeffic
 	{
 		TaylorModel<DATA_TYPE> tmTmp(coefficients[i], numVars);
 		tmTmp.expansion.mul_assign(i+1, 1);
-		tms.push_back(tmTmp);
+		tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -2626,7 +2746,7 @@ TaylorModelVec<DATA_TYPE>::TaylorModelVec(Matrix<DATA_TYPE> & coefficients, cons
 	{
 		DATA_TYPE *p = coefficients.getRowVecRef(i);
 		TaylorModel<DATA_TYPE> tmTmp(p, cols, remainders[i]);
-		tms.push_back(tmTmp);
+		tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -2636,7 +2756,7 @@ TaylorModelVec<DATA_TYPE>::TaylorModelVec(const std::vector<std::vector<DATA_TYP
 	for(unsigned int i=0; i<coefficients.size(); ++i)
 	{
 		TaylorModel<DATA_TYPE> tmTmp(coefficients[i]);
-		tms.push_back(tmTmp);
+		tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -2646,7 +2766,7 @@ TaylorModelVec<DATA_TYPE>::TaylorModelVec(const std::vector<std::vector<DATA_TYP
 	for(unsigned int i=0; i<coefficients.size(); ++i)
 	{
 		TaylorModel<DATA_TYPE> tmTemp(coefficients[i], remainders[i]);
-		tms.push_back(tmTemp);
+		tms.push_back(std::move(tmTemp));
 	}
 }
 
@@ -2741,7 +2861,7 @@ TaylorModelVec<DATA_TYPE>::TaylorModelVec(const unsigned int dim)
 	{
 		TaylorModel<DATA_TYPE> tmTmp(1, domainDim);
 		tmTmp.mul_assign(i, 1);
-		tms.push_back(tmTmp);
+		tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -2751,6 +2871,11 @@ TaylorModelVec<DATA_TYPE>::TaylorModelVec(const TaylorModelVec<DATA_TYPE> & tmv)
 	tms = tmv.tms;
 }
 
+template <class DATA_TYPE>
+TaylorModelVec<DATA_TYPE>::TaylorModelVec(TaylorModelVec<DATA_TYPE> && tmv) noexcept : tms(std::move(tmv.tms))
+{
+}
+
 template <class DATA_TYPE>
 TaylorModelVec<DATA_TYPE>::~TaylorModelVec()
 {
@@ -2906,6 +3031,13 @@ TaylorModelVec<DATA_TYPE> & TaylorModelVec<DATA_TYPE>::operator = (const TaylorM
 	return *this;
 }
 
+template <class DATA_TYPE>
+TaylorModelVec<DATA_TYPE> & TaylorModelVec<DATA_TYPE>::operator = (TaylorModelVec<DATA_TYPE> && tmv) noexcept
+{
+	tms.swap(tmv.tms);
+	return *this;
+}
+
 template <class DATA_TYPE>
 TaylorModelVec<DATA_TYPE> & TaylorModelVec<DATA_TYPE>::operator = (const std::vector<Polynomial<DATA_TYPE> > & pv)
 {
@@ -3033,7 +3165,7 @@ void TaylorModelVec<DATA_TYPE>::derivative(TaylorModelVec<DATA_TYPE> & result, c
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].derivative(tmTmp, varIndex);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3045,7 +3177,7 @@ void TaylorModelVec<DATA_TYPE>::LieDerivative(TaylorModelVec<DATA_TYPE> & result
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].LieDerivative(tmTmp, f, order, cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3057,7 +3189,7 @@ void TaylorModelVec<DATA_TYPE>::LieDerivative(TaylorModelVec<DATA_TYPE> & result
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].LieDerivative(tmTmp, f, orders[i], cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3069,7 +3201,7 @@ void TaylorModelVec<DATA_TYPE>::integral_time(TaylorModelVec<DATA_TYPE> & result
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].integral_time(tmTmp, I);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3081,7 +3213,7 @@ void TaylorModelVec<DATA_TYPE>::integral_time(TaylorModelVec<DATA_TYPE> & result
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].integral_time(tmTmp);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3125,7 +3257,7 @@ void TaylorModelVec<DATA_TYPE>::insert_ctrunc(TaylorModelVec<DATA_TYPE> & result
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].insert_ctrunc(tmTmp, vars, varsPolyRange, domain, order, cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3138,7 +3270,7 @@ void TaylorModelVec<DATA_TYPE>::insert_no_remainder(TaylorModelVec<DATA_TYPE> &
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].insert_no_remainder(tmTmp, vars, numVars, order, cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3148,11 +3280,14 @@ void TaylorModelVec<DATA_TYPE>::insert_ctrunc_normal(TaylorModelVec<DATA_TYPE> &
 {
 	result.clear();
 
+	// the products of the variables are shared by all components
+	std::map<std::vector<unsigned int>, TaylorModel<DATA_TYPE> > products;
+
 	for(unsigned int i=0; i<tms.size(); ++i)
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
-		tms[i].insert_ctrunc_normal(tmTmp, vars, varsPolyRange, step_exp_table, numVars, order, cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		tms[i].insert_ctrunc_normal(tmTmp, vars, varsPolyRange, step_exp_table, numVars, order, cutoff_threshold, products);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3166,7 +3301,7 @@ void TaylorModelVec<DATA_TYPE>::insert_ctrunc(TaylorModelVec<DATA_TYPE> & result
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].insert_ctrunc(tmTmp, vars, varsPolyRange, domain, orders[i], cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3179,7 +3314,7 @@ void TaylorModelVec<DATA_TYPE>::insert_no_remainder(TaylorModelVec<DATA_TYPE> &
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].insert_no_remainder(tmTmp, vars, numVars, orders[i], cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3189,11 +3324,14 @@ void TaylorModelVec<DATA_TYPE>::insert_ctrunc_normal(TaylorModelVec<DATA_TYPE> &
 {
 	result.clear();
 
+	// the products of the variables are shared by all components
+	std::map<std::vector<unsigned int>, TaylorModel<DATA_TYPE> > products;
+
 	for(unsigned int i=0; i<tms.size(); ++i)
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
-		tms[i].insert_ctrunc_normal(tmTmp, vars, varsPolyRange, step_exp_table, numVars, orders[i], cutoff_threshold);
-		result.tms.push_back(tmTmp);
+		tms[i].insert_ctrunc_normal(tmTmp, vars, varsPolyRange, step_exp_table, numVars, orders[i], cutoff_threshold, products);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3207,7 +3345,7 @@ void TaylorModelVec<DATA_TYPE>::evaluate_time(TaylorModelVec<DATA_TYPE> & result
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		tms[i].evaluate_time(tmTmp, step_exp_table);
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 }
 
@@ -3247,8 +3385,8 @@ void TaylorModelVec<DATA_TYPE>::decompose(TaylorModelVec<DATA_TYPE> & linear, Ta
 		TaylorModel<DATA_TYPE> tm_linear, tm_other;
 		tms[i].decompose(tm_linear, tm_other);
 
-		linear.tms.push_back(tm_linear);
-		other.tms.push_back(tm_other);
+		linear.tms.push_back(std::move(tm_linear));
+		other.tms.push_back(std::move(tm_other));
 	}
 }
 
@@ -3280,6 +3418,43 @@ void TaylorModelVec<DATA_TYPE>::cutoff(const Interval & cutoff_threshold)
 		tms[i].cutoff(cutoff_threshold);
 	}
 }
+
+template <class DATA_TYPE>
+template <class DATA_TYPE2>
+void TaylorModelVec<DATA_TYPE>::roundoff_normal(std::vector<Interval> & errors, const std::vector<DATA_TYPE2> & step_exp_table)
+{
+	errors.resize(tms.size());
+
+	for(unsigned int i=0; i<tms.size(); ++i)
+	{
+		tms[i].expansion.roundoff_normal(errors[i], step_exp_table);
+		tms[i].remainder += errors[i];
+	}
+}
+
+template <class DATA_TYPE>
+void TaylorModelVec<DATA_TYPE>::toReal(TaylorModelVec<Real> & result) const
+{
+	result.tms.resize(tms.size());
+
+	for(unsigned int i=0; i<tms.size(); ++i)
+	{
+		tms[i].expansion.toReal(result.tms[i].expansion);
+		result.tms[i].remainder = tms[i].remainder;
+	}
+}
+
+template <class DATA_TYPE>
+void TaylorModelVec<DATA_TYPE>::toFloat(TaylorModelVec<Float> & result) const
+{
+	result.tms.resize(tms.size());
+
+	for(unsigned int i=0; i<tms.size(); ++i)
+	{
+		tms[i].expansion.toFloat(result.tms[i].expansion);
+		result.tms[i].remainder = tms[i].remainder;
+	}
+}
 /*
 template <class DATA_TYPE>
 template <class DATA_TYPE2>
@@ -3332,7 +3507,7 @@ void TaylorModelVec<DATA_TYPE>::Picard_no_remainder(TaylorModelVec<DATA_TYPE> &
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		ode[i].insert_no_remainder(tmTmp, *this, numVars, k, cutoff_threshold);
-		tmvTmp.tms.push_back(tmTmp);
+		tmvTmp.tms.push_back(std::move(tmTmp));
 	}
 
 	TaylorModelVec<DATA_TYPE> tmvTmp2;
@@ -3347,7 +3522,7 @@ void TaylorModelVec<DATA_TYPE>::Picard_no_remainder_assign(const TaylorModelVec<
 {
 	TaylorModelVec<DATA_TYPE> result;
 	Picard_no_remainder(result, x0, ode, numVars, order, cutoff_threshold);
-	*this = result;
+	*this = std::move(result);
 }
 
 template <class DATA_TYPE>
@@ -3362,7 +3537,7 @@ void TaylorModelVec<DATA_TYPE>::Picard_no_remainder(TaylorModelVec<DATA_TYPE> &
 
 		TaylorModel<DATA_TYPE> tmTmp;
 		ode[i].insert_no_remainder(tmTmp, *this, numVars, k, cutoff_threshold);
-		tmvTmp.tms.push_back(tmTmp);
+		tmvTmp.tms.push_back(std::move(tmTmp));
 	}
 
 	TaylorModelVec<DATA_TYPE> tmvTmp2;
@@ -3377,7 +3552,7 @@ void TaylorModelVec<DATA_TYPE>::Picard_no_remainder_assign(const TaylorModelVec<
 {
 	TaylorModelVec<DATA_TYPE> result;
 	Picard_no_remainder(result, x0, ode, numVars, orders, cutoff_threshold);
-	*this = result;
+	*this = std::move(result);
 }
 
 template <class DATA_TYPE>
@@ -3392,7 +3567,7 @@ void TaylorModelVec<DATA_TYPE>::Picard_ctrunc_normal(TaylorModelVec<DATA_TYPE> &
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		ode[i].insert_ctrunc_normal(tmTmp, intermediate_ranges, *this, varsPolyRange, step_exp_table, numVars, k, cutoff_threshold);
-		tmvTmp.tms.push_back(tmTmp);
+		tmvTmp.tms.push_back(std::move(tmTmp));
 	}
 
 	TaylorModelVec<DATA_TYPE> tmvTmp2;
@@ -3430,7 +3605,7 @@ void TaylorModelVec<DATA_TYPE>::Picard_ctrunc_normal(TaylorModelVec<DATA_TYPE> &
 
 		TaylorModel<DATA_TYPE> tmTmp;
 		ode[i].insert_ctrunc_normal(tmTmp, intermediate_ranges, *this, varsPolyRange, step_exp_table, numVars, k, cutoff_threshold);
-		tmvTmp.tms.push_back(tmTmp);
+		tmvTmp.tms.push_back(std::move(tmTmp));
 	}
 
 	TaylorModelVec<DATA_TYPE> tmvTmp2;
@@ -3451,7 +3626,7 @@ void TaylorModelVec<DATA_TYPE>::Picard_no_remainder(TaylorModelVec<DATA_TYPE> &
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		ode[i].evaluate_no_remainder(tmTmp, this->tms, k, cutoff_threshold, numVars);
-		tmvTmp.tms.push_back(tmTmp);
+		tmvTmp.tms.push_back(std::move(tmTmp));
 	}
 
 	TaylorModelVec tmvTmp2;
@@ -3466,7 +3641,7 @@ void TaylorModelVec<DATA_TYPE>::Picard_no_remainder_assign(const TaylorModelVec<
 {
 	TaylorModelVec<DATA_TYPE> result;
 	Picard_no_remainder(result, x0, ode, numVars, order, cutoff_threshold);
-	*this = result;
+	*this = std::move(result);
 }
 
 template <class DATA_TYPE>
@@ -3481,7 +3656,7 @@ void TaylorModelVec<DATA_TYPE>::Picard_ctrunc_normal(TaylorModelVec<DATA_TYPE> &
 	{
 		TaylorModel<DATA_TYPE> tmTmp;
 		ode[i].evaluate(tmTmp, this->tms, k, step_exp_table, cutoff_threshold, numVars, intermediate_ranges, setting);
-		tmvTmp.tms.push_back(tmTmp);
+		tmvTmp.tms.push_back(std::move(tmTmp));
 	}
 
 	TaylorModelVec tmvTmp2;
@@ -3710,7 +3885,7 @@ TaylorModelVec<DATA_TYPE> operator * (const Matrix<DATA_TYPE> & A, const TaylorM
 			tmTmp += tmv.tms[j] * A.data[pos + j];
 		}
 
-		result.tms.push_back(tmTmp);
+		result.tms.push_back(std::move(tmTmp));
 	}
 
 	return result;
@@ -8,22 +8,27 @@
 
 #include "Interval.h"
 #include "Variables.h"
+#include "PoolAllocator.h"
 
 namespace flowstar
 {
 
+// the degrees of a term are kept in the blocks of the thread pool
+typedef std::vector<unsigned int, Pool_Allocator<unsigned int> > Degree_Vector;
+
 template <class DATA_TYPE>
 class Term
 {
 protected:
 	DATA_TYPE coefficient;					// the coefficient of the term
-	std::vector<unsigned int> degrees;		// the degrees of the variables, e.g., [2,0,4] is the notation for x1^2 x3^4
+	Degree_Vector degrees;					// the degrees of the variables, e.g., [2,0,4] is the notation for x1^2 x3^4
 	unsigned int d;			        		// the degree of the term, it is the sum of the values in degrees.
 
 public:
 	Term();		// empty term.
 	Term(const DATA_TYPE & c, const std::vector<unsigned int> & degs);
 	Term(const Term<DATA_TYPE> & term);
+	Term(Term<DATA_TYPE> && term) noexcept;
 	Term(const DATA_TYPE & c);				// a constant
 	Term(const DATA_TYPE & c, const unsigned int numVars);
 	~Term();
@@ -37,7 +42,13 @@ public:
 	template <class DATA_TYPE2>
 	void intEvalNormal(Interval & result, const std::vector<DATA_TYPE2> & step_exp_table) const;
 
+	// the same in double precision, as the bounds of the coefficient and the bounds of the monomial over the normalized domain
+	// returns false if the coefficient is not finite
+	template <class DATA_TYPE2>
+	bool boundsNormal(double & coeffLo, double & coeffUp, double & monoLo, double & monoUp, const std::vector<DATA_TYPE2> & step_exp_table) const;
+
 	Term<DATA_TYPE> & operator = (const Term<DATA_TYPE> & term);
+	Term<DATA_TYPE> & operator = (Term<DATA_TYPE> && term) noexcept;
 
 	Term<DATA_TYPE> & operator += (const Term<DATA_TYPE> & term);			// we assume the two terms can be added up
 	Term<DATA_TYPE> & operator -= (const Term<DATA_TYPE> & term);
@@ -95,7 +106,7 @@ Term<DATA_TYPE>::Term()
 }
 
 template <class DATA_TYPE>
-Term<DATA_TYPE>::Term(const DATA_TYPE & c, const std::vector<unsigned int> & degs) : coefficient(c), degrees(degs)
+Term<DATA_TYPE>::Term(const DATA_TYPE & c, const std::vector<unsigned int> & degs) : coefficient(c), degrees(degs.begin(), degs.end()), d(0)
 {
 	for(int i=0; i<degs.size(); ++i)
 	{
@@ -108,6 +119,11 @@ Term<DATA_TYPE>::Term(const Term & term) : coefficient(term.coefficient), degree
 {
 }
 
+template <class DATA_TYPE>
+Term<DATA_TYPE>::Term(Term && term) noexcept : coefficient(term.coefficient), degrees(std::move(term.degrees)), d(term.d)
+{
+}
+
 template <class DATA_TYPE>
 Term<DATA_TYPE>::Term(const DATA_TYPE & c) : coefficient(c), d(0)
 {
@@ -207,6 +223,57 @@ void Term<DATA_TYPE>::intEvalNormal(Interval & result, const std::vector<DATA_TY
 	result *= intFactor;
 }
 
+template <class DATA_TYPE>
+template <class DATA_TYPE2>
+bool Term<DATA_TYPE>::boundsNormal(double & coeffLo, double & coeffUp, double & monoLo, double & monoUp, const std::vector<DATA_TYPE2> & step_exp_table) const
+{
+	double_bounds(coeffLo, coeffUp, coefficient);
+
+	if(!std::isfinite(coeffLo) || !std::isfinite(coeffUp))
+	{
+		return false;
+	}
+
+	if(degrees.size() == 0)
+	{
+		coeffLo = coeffUp = 0;
+		monoLo = monoUp = 0;
+		return true;
+	}
+
+	double_bounds(monoLo, monoUp, step_exp_table[degrees[0]]);
+
+	// the factor of the state variables is 1, [0,1] if all the degrees are even, or [-1,1]
+	bool bEven = false;
+
+	for(unsigned int i=1; i<degrees.size(); ++i)
+	{
+		if(degrees[i] == 0)
+		{
+			continue;
+		}
+		else if(degrees[i]%2 == 0)
+		{
+			bEven = true;
+		}
+		else
+		{
+			double m = std::max(-monoLo, monoUp);
+			monoLo = -m;
+			monoUp = m;
+			return true;
+		}
+	}
+
+	if(bEven)
+	{
+		monoLo = std::min(monoLo, 0.0);
+		monoUp = std::max(monoUp, 0.0);
+	}
+
+	return true;
+}
+
 template <class DATA_TYPE>
 Term<DATA_TYPE> & Term<DATA_TYPE>::operator = (const Term<DATA_TYPE> & term)
 {
@@ -220,6 +287,16 @@ Term<DATA_TYPE> & Term<DATA_TYPE>::operator = (const Term<DATA_TYPE> & term)
 	return *this;
 }
 
+template <class DATA_TYPE>
+Term<DATA_TYPE> & Term<DATA_TYPE>::operator = (Term<DATA_TYPE> && term) noexcept
+{
+	coefficient = term.coefficient;
+	degrees.swap(term.degrees);
+	d = term.d;
+
+	return *this;
+}
+
 template <class DATA_TYPE>
 Term<DATA_TYPE> & Term<DATA_TYPE>::operator += (const Term<DATA_TYPE> & term)
 {
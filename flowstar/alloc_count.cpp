@@ -0,0 +1,125 @@
+/*---
+  Counts the heap allocations of the flowpipe steps, and fails if a step allocates more than its bound.
+  Build and run with "make alloc_count && ./alloc_count".
+---*/
+
+#include "Continuous.h"
+
+#include <atomic>
+#include <new>
+
+using namespace flowstar;
+
+// The steady-state operator new calls of one step, between the 10th and the 20th step of the Van der Pol
+// oscillator below. They only count the C++ containers, MPFR and GMP allocate with malloc.
+#define END_OF_TIME_STEP_BOUND		260		// reach_end_of_time, only the latest flowpipe is kept
+#define REACH_STEP_BOUND			450		// reach, every flowpipe is kept
+
+static std::atomic<long> newCount(0);
+
+void *operator new(std::size_t size)
+{
+	++newCount;
+
+	void *p = std::malloc(size > 0 ? size : 1);
+
+	if(p == NULL)
+	{
+		throw std::bad_alloc();
+	}
+
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+// the operator new calls of a run over the given number of steps
+static long count_run(const Deterministic_Continuous_Dynamics & dynamics, Computational_Setting & setting, const Flowpipe & initial_set, const double step, const unsigned int steps, const bool bEndOfTime)
+{
+	std::vector<Constraint> unsafeSet;
+	Result_of_Reachability result;
+
+	setting.setTime(step * steps);
+
+	long before = newCount;
+
+	if(bEndOfTime)
+	{
+		dynamics.reach_end_of_time(result, setting, initial_set, unsafeSet);
+	}
+	else
+	{
+		dynamics.reach(result, setting, initial_set, unsafeSet);
+	}
+
+	long count = newCount - before;
+
+	if(result.num_of_flowpipes != steps)
+	{
+		printf("only %lu of %u steps completed\n", result.num_of_flowpipes, steps);
+		exit(1);
+	}
+
+	return count;
+}
+
+int main()
+{
+	unsigned int order = 6;
+	unsigned int steps = 10;
+	double step = 0.02;
+
+	// Van der Pol oscillator
+	stateVars.declareVar("x");
+	stateVars.declareVar("y");
+
+	std::vector<Expression_AST<Real> > ode;
+	ode.push_back(Expression_AST<Real>("y"));
+	ode.push_back(Expression_AST<Real>("y - x - x^2*y"));
+
+	Deterministic_Continuous_Dynamics dynamics(ode);
+
+	Computational_Setting setting;
+	setting.setFixedStepsize(step, order);
+	setting.setTime(step);
+	setting.setCutoffThreshold(1e-10);
+	setting.setQueueSize(1000);
+	setting.setRemainderEstimation(std::vector<Interval>(2, Interval(-0.01, 0.01)));
+	setting.printOff();
+	setting.prepare();
+
+	std::vector<Interval> box;
+	box.push_back(Interval(1.25, 1.3));
+	box.push_back(Interval(2.3, 2.35));
+	Flowpipe initial_set(box);
+
+	int failures = 0;
+
+	for(int bEndOfTime = 1; bEndOfTime >= 0; --bEndOfTime)
+	{
+		long bound = bEndOfTime ? END_OF_TIME_STEP_BOUND : REACH_STEP_BOUND;
+
+		// the first run fills the per-thread pools, and the difference of the two runs leaves out the setup of a run
+		count_run(dynamics, setting, initial_set, step, steps, bEndOfTime);
+		long shortRun = count_run(dynamics, setting, initial_set, step, steps, bEndOfTime);
+		long longRun = count_run(dynamics, setting, initial_set, step, 2 * steps, bEndOfTime);
+		long perStep = (longRun - shortRun + steps - 1) / steps;
+
+		printf("%s: %ld calls of operator new per step, bound %ld\n", bEndOfTime ? "reach_end_of_time" : "reach", perStep, bound);
+
+		if(perStep > bound)
+		{
+			++failures;
+		}
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,474 @@
+/*---
+  Email: Xin Chen <chenxin415@gmail.com> if you have questions or comments.
+  The code is released as is under the GNU General Public License (GPL).
+---*/
+
+#include "expression.h"
+
+using namespace flowstar;
+
+Expression_Parser::Expression_Parser(const Variables & vars) : variables(vars)
+{
+	str = pos = end = NULL;
+}
+
+Expression_Parser::~Expression_Parser()
+{
+}
+
+bool Expression_Parser::parse(Expression_AST<Interval> & result, const char *strExpression, const unsigned int length)
+{
+	str = pos = strExpression;
+	end = strExpression + length;
+	error.clear();
+
+	// a cached text is only valid within one expression, e.g. the variables may be declared in between
+	cache.clear();
+
+	// match the parentheses first, so that a cached group is skipped without being scanned
+	closing.assign(length, -1);
+	std::vector<int> open;
+
+	for(unsigned int i=0; i<length; ++i)
+	{
+		if(str[i] == '(')
+		{
+			open.push_back(i);
+		}
+		else if(str[i] == ')')
+		{
+			if(open.size() == 0)
+			{
+				pos = str + i;
+				return fail("unmatched ')'");
+			}
+
+			closing[open.back()] = i;
+			open.pop_back();
+		}
+	}
+
+	if(open.size() > 0)
+	{
+		pos = str + open.back();
+		return fail("unmatched '('");
+	}
+
+	if(!parseSum(result))
+	{
+		return false;
+	}
+
+	skipSpaces();
+
+	if(pos != end)
+	{
+		return fail("unexpected character");
+	}
+
+	return true;
+}
+
+bool Expression_Parser::parse(Expression_AST<Interval> & result, const std::string & strExpression)
+{
+	return parse(result, strExpression.c_str(), strExpression.size());
+}
+
+unsigned int Expression_Parser::cacheSize() const
+{
+	return cache.size();
+}
+
+void Expression_Parser::clearCache()
+{
+	cache.clear();
+}
+
+void Expression_Parser::skipSpaces()
+{
+	while(pos < end)
+	{
+		if(*pos == ' ' || *pos == '\t' || *pos == '\r' || *pos == '\n')
+		{
+			++pos;
+		}
+		else if(*pos == '#')
+		{
+			// comment until the end of the line
+			while(pos < end && *pos != '\n')
+			{
+				++pos;
+			}
+		}
+		else
+		{
+			break;
+		}
+	}
+}
+
+bool Expression_Parser::fail(const std::string & msg)
+{
+	char strPos[32];
+	sprintf(strPos, " at column %d", (int)(pos - str) + 1);
+
+	error = msg + strPos;
+	return false;
+}
+
+bool Expression_Parser::parseSum(Expression_AST<Interval> & result)
+{
+	if(!parseProduct(result))
+	{
+		return false;
+	}
+
+	while(true)
+	{
+		skipSpaces();
+
+		if(pos == end || (*pos != '+' && *pos != '-'))
+		{
+			return true;
+		}
+
+		char opt = *pos;
+		++pos;
+
+		Expression_AST<Interval> operand;
+
+		if(!parseProduct(operand))
+		{
+			return false;
+		}
+
+		if(opt == '+')
+		{
+			result += operand;
+		}
+		else
+		{
+			result -= operand;
+		}
+	}
+}
+
+bool Expression_Parser::parseProduct(Expression_AST<Interval> & result)
+{
+	if(!parseUnary(result))
+	{
+		return false;
+	}
+
+	while(true)
+	{
+		skipSpaces();
+
+		if(pos == end || (*pos != '*' && *pos != '/'))
+		{
+			return true;
+		}
+
+		char opt = *pos;
+		++pos;
+
+		Expression_AST<Interval> operand;
+
+		if(!parseUnary(operand))
+		{
+			return false;
+		}
+
+		if(opt == '*')
+		{
+			result *= operand;
+		}
+		else
+		{
+			result /= operand;
+		}
+	}
+}
+
+bool Expression_Parser::parseUnary(Expression_AST<Interval> & result)
+{
+	skipSpaces();
+
+	// as in the lexer, a '-' right before a digit starts a negative number, which binds tighter than '^'
+	if(pos < end && *pos == '-' && !(pos + 1 < end && (isdigit((unsigned char)pos[1]) || pos[1] == '.')))
+	{
+		++pos;
+
+		if(!parseUnary(result))
+		{
+			return false;
+		}
+
+		result.inv_assign();
+		return true;
+	}
+
+	return parsePower(result);
+}
+
+bool Expression_Parser::parsePower(Expression_AST<Interval> & result)
+{
+	if(!parsePrimary(result))
+	{
+		return false;
+	}
+
+	while(true)
+	{
+		skipSpaces();
+
+		if(pos == end || *pos != '^')
+		{
+			return true;
+		}
+
+		++pos;
+		skipSpaces();
+
+		double exponent;
+
+		if(!parseNumber(exponent))
+		{
+			return false;
+		}
+
+		result.pow_assign((int)exponent);
+	}
+}
+
+bool Expression_Parser::parsePrimary(Expression_AST<Interval> & result)
+{
+	skipSpaces();
+
+	if(pos == end)
+	{
+		return fail("unexpected end of the expression");
+	}
+
+	if(*pos == '(')
+	{
+		return parseGroup(result, pos);
+	}
+
+	if(*pos == '[')
+	{
+		++pos;
+		skipSpaces();
+
+		double lo, up;
+
+		if(!parseNumber(lo))
+		{
+			return false;
+		}
+
+		skipSpaces();
+
+		if(pos == end || *pos != ',')
+		{
+			return fail("',' expected");
+		}
+
+		++pos;
+		skipSpaces();
+
+		if(!parseNumber(up))
+		{
+			return false;
+		}
+
+		skipSpaces();
+
+		if(pos == end || *pos != ']')
+		{
+			return fail("']' expected");
+		}
+
+		++pos;
+
+		Interval I(lo, up);
+		result = Expression_AST<Interval>(I);
+		return true;
+	}
+
+	if(isalpha((unsigned char)*pos) || *pos == '_')
+	{
+		const char *start = pos;
+
+		while(pos < end && (isalnum((unsigned char)*pos) || *pos == '_' || *pos == '.'))
+		{
+			++pos;
+		}
+
+		std::string name(start, pos);
+
+		if(name == "exp" || name == "sin" || name == "cos" || name == "log" || name == "sqrt")
+		{
+			skipSpaces();
+
+			if(pos == end || *pos != '(')
+			{
+				return fail("'(' expected after " + name);
+			}
+
+			return parseGroup(result, start);
+		}
+
+		int id = variables.getIDForVar(name);
+
+		if(id < 0)
+		{
+			pos = start;
+			return fail(name + " is not declared");
+		}
+
+		result = Expression_AST<Interval>(name, variables);
+		return true;
+	}
+
+	double c;
+
+	if(!parseNumber(c))
+	{
+		return false;
+	}
+
+	result = Expression_AST<Interval>(c);
+	return true;
+}
+
+bool Expression_Parser::parseNumber(double & value)
+{
+	const char *start = pos;
+
+	if(pos < end && *pos == '-')
+	{
+		++pos;
+	}
+
+	const char *digits = pos;
+
+	while(pos < end && isdigit((unsigned char)*pos))
+	{
+		++pos;
+	}
+
+	if(pos < end && *pos == '.')
+	{
+		++pos;
+
+		while(pos < end && isdigit((unsigned char)*pos))
+		{
+			++pos;
+		}
+	}
+
+	if(pos == digits)
+	{
+		pos = start;
+		return fail("number expected");
+	}
+
+	if(pos + 1 < end && (*pos == 'e' || *pos == 'E'))
+	{
+		const char *exponent = pos + 1;
+
+		if(exponent < end && (*exponent == '+' || *exponent == '-'))
+		{
+			++exponent;
+		}
+
+		if(exponent < end && isdigit((unsigned char)*exponent))
+		{
+			pos = exponent;
+
+			while(pos < end && isdigit((unsigned char)*pos))
+			{
+				++pos;
+			}
+		}
+	}
+
+	value = atof(std::string(start, pos).c_str());
+	return true;
+}
+
+// a parenthesized subexpression, or a function call if start is before pos, cached by its text
+bool Expression_Parser::parseGroup(Expression_AST<Interval> & result, const char *start)
+{
+	const char *close = str + closing[pos - str];
+	std::string key(start, close + 1);
+
+	std::map<std::string, Expression_AST<Interval> >::const_iterator iter = cache.find(key);
+
+	if(iter != cache.end())
+	{
+		result = iter->second;
+		pos = close + 1;
+		return true;
+	}
+
+	std::string function(start, pos);
+	++pos;
+
+	if(!parseSum(result))
+	{
+		return false;
+	}
+
+	skipSpaces();
+
+	if(pos != close)
+	{
+		return fail("')' expected");
+	}
+
+	++pos;
+
+	// the nodes are never modified in place, so the cached tree can be shared
+	while(function.size() > 0 && (function.back() == ' ' || function.back() == '\t'))
+	{
+		function.pop_back();
+	}
+
+	if(function == "exp")
+	{
+		result.exp_assign();
+	}
+	else if(function == "sin")
+	{
+		result.sin_assign();
+	}
+	else if(function == "cos")
+	{
+		result.cos_assign();
+	}
+	else if(function == "log")
+	{
+		result.log_assign();
+	}
+	else if(function == "sqrt")
+	{
+		result.sqrt_assign();
+	}
+
+	cache[key] = result;
+	return true;
+}
+
+void flowstar::parseExpressionAST(Expression_AST<Interval> & result, const std::string & strExpression, const Variables & variables)
+{
+	// a parser per call, its cache only lives for one expression anyway
+	Expression_Parser parser(variables);
+
+	if(!parser.parse(result, strExpression))
+	{
+		fprintf(stderr, "Error in expression \"%s\": %s\n", strExpression.c_str(), parser.error.c_str());
+		exit(1);
+	}
+}
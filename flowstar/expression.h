@@ -29,6 +29,16 @@
 #define VAR_ID			0
 #define PAR_ID			1
 
+#define PARITY_EVEN		1
+#define PARITY_ODD		2
+
+#define PICARD_CONST	0
+#define PICARD_VAR		1
+#define PICARD_PLUS		2
+#define PICARD_MINU		3
+#define PICARD_NEG		4
+#define PICARD_MULT		5
+
 void parseExpression();
 
 namespace flowstar
@@ -333,6 +343,9 @@ class AST_Node;
 template <class DATA_TYPE>
 class Expression_AST;
 
+template <class DATA_TYPE>
+class Incremental_Picard;
+
 template <class DATA_TYPE>
 class Node_Operator
 {
@@ -468,6 +481,11 @@ public:
 //	void output(std::string & expression, const Taylor_Model_Computation_Setting & setting) const;
 	void output(std::string & expression, const Variables & variables) const;
 
+	int parity(const std::vector<int> & signs) const;
+
+	template <class DATA_TYPE2>
+	int toPicard(Incremental_Picard<DATA_TYPE2> & picard) const;
+
 	void toReal(std::shared_ptr<AST_Node<Real> > & pNode) const;
 
 	template <class DATA_TYPE2>
@@ -1960,6 +1978,161 @@ void AST_Node<DATA_TYPE>::output(std::string & expression, const Variables & var
 	}
 }
 
+template <class DATA_TYPE>
+int AST_Node<DATA_TYPE>::parity(const std::vector<int> & signs) const
+{
+	switch(node_type)
+	{
+	case NODE_UNA_OPT:
+	{
+		int p = node_value.opt.left_operand->parity(signs);
+
+		switch(node_value.opt.type)
+		{
+		case OPT_NEG:
+		case OPT_SIN:
+			return p;
+
+		case OPT_COS:
+			return p != 0 ? PARITY_EVEN : 0;
+
+		default:	// exp, log and sqrt
+			return p & PARITY_EVEN;
+		}
+	}
+	case NODE_BIN_OPT:
+	{
+		int p1 = node_value.opt.left_operand->parity(signs);
+
+		if(node_value.opt.type == OPT_POW)
+		{
+			int n = (int)node_value.opt.right_operand->node_value.constant.toDouble();
+			int result = p1 & PARITY_EVEN;
+
+			if(p1 & PARITY_ODD)
+			{
+				result |= (n % 2 == 0) ? PARITY_EVEN : PARITY_ODD;
+			}
+
+			return result;
+		}
+
+		int p2 = node_value.opt.right_operand->parity(signs);
+
+		if(node_value.opt.type == OPT_PLUS || node_value.opt.type == OPT_MINU)
+		{
+			return p1 & p2;
+		}
+
+		// multiplication and division
+		int result = 0;
+
+		if(((p1 & PARITY_EVEN) && (p2 & PARITY_EVEN)) || ((p1 & PARITY_ODD) && (p2 & PARITY_ODD)))
+		{
+			result |= PARITY_EVEN;
+		}
+
+		if(((p1 & PARITY_EVEN) && (p2 & PARITY_ODD)) || ((p1 & PARITY_ODD) && (p2 & PARITY_EVEN)))
+		{
+			result |= PARITY_ODD;
+		}
+
+		return result;
+	}
+	case NODE_VAR:
+		if(node_value.var.type == VAR_ID && node_value.var.id < signs.size() && signs[node_value.var.id] < 0)
+		{
+			return PARITY_ODD;
+		}
+		else
+		{
+			return PARITY_EVEN;
+		}
+
+	default:	// constant
+		return PARITY_EVEN;
+	}
+}
+
+template <class DATA_TYPE>
+template <class DATA_TYPE2>
+int AST_Node<DATA_TYPE>::toPicard(Incremental_Picard<DATA_TYPE2> & picard) const
+{
+	switch(node_type)
+	{
+	case NODE_UNA_OPT:
+	{
+		if(node_value.opt.type != OPT_NEG)
+		{
+			return -1;
+		}
+
+		int operand = node_value.opt.left_operand->toPicard(picard);
+		return operand < 0 ? -1 : picard.addNode(PICARD_NEG, operand, -1);
+	}
+	case NODE_BIN_OPT:
+	{
+		int left = node_value.opt.left_operand->toPicard(picard);
+
+		if(left < 0)
+		{
+			return -1;
+		}
+
+		if(node_value.opt.type == OPT_POW)
+		{
+			int n = (int)node_value.opt.right_operand->node_value.constant.toDouble();
+
+			if(n == 0)
+			{
+				return picard.addConstant(DATA_TYPE(1));
+			}
+
+			int result = left;
+
+			for(int i=1; i<n; ++i)
+			{
+				result = picard.addNode(PICARD_MULT, result, left);
+			}
+
+			return result;
+		}
+
+		if(node_value.opt.type == OPT_DIV)
+		{
+			return -1;
+		}
+
+		int right = node_value.opt.right_operand->toPicard(picard);
+
+		if(right < 0)
+		{
+			return -1;
+		}
+
+		switch(node_value.opt.type)
+		{
+		case OPT_PLUS:
+			return picard.addNode(PICARD_PLUS, left, right);
+		case OPT_MINU:
+			return picard.addNode(PICARD_MINU, left, right);
+		default:
+			return picard.addNode(PICARD_MULT, left, right);
+		}
+	}
+	case NODE_VAR:
+		if(node_value.var.type != VAR_ID)
+		{
+			return -1;
+		}
+
+		return picard.addNode(PICARD_VAR, node_value.var.id, -1);
+
+	default:	// constant
+		return picard.addConstant(node_value.constant);
+	}
+}
+
 template <>
 inline void AST_Node<Interval>::toReal(std::shared_ptr<AST_Node<Real> > & pNode) const
 {
@@ -2012,7 +2185,7 @@ public:
 
 	void toReal(Expression_AST<Real> & expression) const;
 
-	// using lex
+	// using Expression_Parser
 	Expression_AST(const std::string & strExpression);
 //	Expression_AST(const std::string & strExpression, const Variables & variables, const Parameters & parameters);
 
@@ -2040,6 +2213,13 @@ public:
 
 	bool isConstant(DATA_TYPE & c) const;
 
+	// PARITY_EVEN if e(s*x) = e(x) and PARITY_ODD if e(s*x) = -e(x) where s is the sign of every variable, 0 if unknown
+	int parity(const std::vector<int> & signs) const;
+
+	// adds the expression to an incremental Picard operator, returns the id of its value or -1 if it is not a polynomial
+	template <class DATA_TYPE2>
+	int toPicard(Incremental_Picard<DATA_TYPE2> & picard) const;
+
 	Expression_AST & operator = (const Expression_AST & expression);
 	Expression_AST & operator += (const Expression_AST & expression);
 	Expression_AST & operator -= (const Expression_AST & expression);
@@ -2059,6 +2239,47 @@ public:
 };
 
 
+// reentrant recursive descent parser for the expressions accepted by "expression ast { ... }"
+class Expression_Parser
+{
+protected:
+	const Variables & variables;
+	std::map<std::string, Expression_AST<Interval> > cache;	// parenthesized subexpressions and function calls of the current expression
+	const char *str;
+	const char *pos;
+	const char *end;
+	std::vector<int> closing;								// position of the matching ')' of every '('
+
+public:
+	std::string error;
+
+public:
+	Expression_Parser(const Variables & vars);
+	~Expression_Parser();
+
+	bool parse(Expression_AST<Interval> & result, const char *strExpression, const unsigned int length);
+	bool parse(Expression_AST<Interval> & result, const std::string & strExpression);
+
+	unsigned int cacheSize() const;
+	void clearCache();
+
+protected:
+	void skipSpaces();
+	bool fail(const std::string & msg);
+
+	bool parseSum(Expression_AST<Interval> & result);
+	bool parseProduct(Expression_AST<Interval> & result);
+	bool parseUnary(Expression_AST<Interval> & result);
+	bool parsePower(Expression_AST<Interval> & result);
+	bool parsePrimary(Expression_AST<Interval> & result);
+	bool parseNumber(double & value);
+	bool parseGroup(Expression_AST<Interval> & result, const char *start);
+};
+
+// parses over the given variables, exits on syntax errors
+void parseExpressionAST(Expression_AST<Interval> & result, const std::string & strExpression, const Variables & variables);
+
+
 template <class DATA_TYPE>
 Expression_AST<DATA_TYPE>::Expression_AST()
 {
@@ -2102,31 +2323,16 @@ inline void Expression_AST<Interval>::toReal(Expression_AST<Real> & expression)
 template <>
 inline Expression_AST<Interval>::Expression_AST(const std::string & strExpression)
 {
-	expression_ast_setting.clear();
-
-	std::string prefix(str_prefix_expression_ast);
-	std::string suffix(str_suffix);
-
-	expression_ast_setting.strExpression = prefix + strExpression + suffix;
-
-	parseExpression();
-
-	*this = expression_ast_setting.result;
+	parseExpressionAST(*this, strExpression, stateVars);
 }
 
 template <>
 inline Expression_AST<Real>::Expression_AST(const std::string & strExpression)
 {
-	expression_ast_setting.clear();
-
-	std::string prefix(str_prefix_expression_ast);
-	std::string suffix(str_suffix);
+	Expression_AST<Interval> expression;
+	parseExpressionAST(expression, strExpression, stateVars);
 
-	expression_ast_setting.strExpression = prefix + strExpression + suffix;
-
-	parseExpression();
-
-	expression_ast_setting.result.toReal(*this);
+	expression.toReal(*this);
 }
 
 template <class DATA_TYPE>
@@ -2200,6 +2406,19 @@ bool Expression_AST<DATA_TYPE>::isConstant(DATA_TYPE & c) const
 
 }
 
+template <class DATA_TYPE>
+int Expression_AST<DATA_TYPE>::parity(const std::vector<int> & signs) const
+{
+	return root->parity(signs);
+}
+
+template <class DATA_TYPE>
+template <class DATA_TYPE2>
+int Expression_AST<DATA_TYPE>::toPicard(Incremental_Picard<DATA_TYPE2> & picard) const
+{
+	return root == nullptr ? -1 : root->toPicard(picard);
+}
+
 template <class DATA_TYPE>
 Expression_AST<DATA_TYPE> & Expression_AST<DATA_TYPE>::operator = (const Expression_AST<DATA_TYPE> & expression)
 {
@@ -2299,6 +2518,201 @@ void Expression_AST<DATA_TYPE>::sqrt_assign()
 }
 
 
+
+// Picard iteration of a polynomial ODE which only computes the new order at every iteration.
+// Once x is exact up to degree k - 1, the terms of degree < k of f(x) do not change any more,
+// so the homogeneous parts of the value of every node of the ODE are kept, and the part of
+// degree k of a product is the Cauchy sum of the parts of its operands, as in the Taylor
+// coefficient recurrences of automatic differentiation.
+template <class DATA_TYPE>
+class Incremental_Picard
+{
+protected:
+	struct Node
+	{
+		int type;
+		int left;		// the operand, or the variable id of a PICARD_VAR node
+		int right;
+		Polynomial<DATA_TYPE> constant;
+		std::vector<Polynomial<DATA_TYPE> > parts;	// parts[k] is the part of degree k of the value
+	};
+
+	std::vector<Node> nodes;		// the operands of a node are before it
+	std::vector<int> roots;		// -1 if the ODE is not a polynomial
+
+public:
+	unsigned int numVars;
+
+	template <class DATA_TYPE2>
+	Incremental_Picard(const std::vector<Expression_AST<DATA_TYPE2> > & ode, const unsigned int numVars);
+
+	int addNode(const int type, const int left, const int right);
+
+	template <class DATA_TYPE2>
+	int addConstant(const DATA_TYPE2 & c);
+
+	// the same x as the iterations x.Picard_no_remainder_assign(x0, ode, numVars, i, cutoff_threshold) for i = 1, ..., order from x = x0
+	template <class DATA_TYPE2>
+	void iterate(TaylorModelVec<DATA_TYPE> & x, const TaylorModelVec<DATA_TYPE> & x0, const std::vector<Expression_AST<DATA_TYPE2> > & ode, const unsigned int order, const Interval & cutoff_threshold);
+};
+
+template <class DATA_TYPE>
+template <class DATA_TYPE2>
+Incremental_Picard<DATA_TYPE>::Incremental_Picard(const std::vector<Expression_AST<DATA_TYPE2> > & ode, const unsigned int numVars)
+{
+	this->numVars = numVars;
+
+	for(unsigned int i=0; i<ode.size(); ++i)
+	{
+		int root = ode[i].toPicard(*this);
+
+		if(root < 0)
+		{
+			roots.clear();
+			nodes.clear();
+			break;
+		}
+
+		roots.push_back(root);
+	}
+}
+
+template <class DATA_TYPE>
+int Incremental_Picard<DATA_TYPE>::addNode(const int type, const int left, const int right)
+{
+	Node node;
+	node.type = type;
+	node.left = left;
+	node.right = right;
+	nodes.push_back(node);
+
+	return nodes.size() - 1;
+}
+
+template <class DATA_TYPE>
+template <class DATA_TYPE2>
+int Incremental_Picard<DATA_TYPE>::addConstant(const DATA_TYPE2 & c)
+{
+	int id = addNode(PICARD_CONST, -1, -1);
+	nodes[id].constant = Polynomial<DATA_TYPE>(c, numVars);
+
+	return id;
+}
+
+template <>
+template <>
+inline int Incremental_Picard<Real>::addConstant<Interval>(const Interval & c)
+{
+	int id = addNode(PICARD_CONST, -1, -1);
+	nodes[id].constant = Polynomial<Real>(c.toReal(), numVars);
+
+	return id;
+}
+
+template <class DATA_TYPE>
+template <class DATA_TYPE2>
+void Incremental_Picard<DATA_TYPE>::iterate(TaylorModelVec<DATA_TYPE> & x, const TaylorModelVec<DATA_TYPE> & x0, const std::vector<Expression_AST<DATA_TYPE2> > & ode, const unsigned int order, const Interval & cutoff_threshold)
+{
+	x = x0;
+
+	if(roots.size() != ode.size() || roots.size() != x0.tms.size())
+	{
+		// not a polynomial ODE, every iteration composes the whole ODE
+		for(unsigned int i=1; i<=order; ++i)
+		{
+			x.Picard_no_remainder_assign(x0, ode, numVars, i, cutoff_threshold);
+		}
+
+		return;
+	}
+
+	// xParts[i][k] is the part of degree k of the i-th component of x
+	std::vector<std::vector<Polynomial<DATA_TYPE> > > xParts(x0.tms.size(), std::vector<Polynomial<DATA_TYPE> >(order + 1));
+
+	for(unsigned int i=0; i<x0.tms.size(); ++i)
+	{
+		for(unsigned int k=0; k<=order; ++k)
+		{
+			x0.tms[i].expansion.homogeneous(xParts[i][k], k);
+		}
+	}
+
+	for(unsigned int j=0; j<nodes.size(); ++j)
+	{
+		nodes[j].parts.clear();
+	}
+
+	// the iteration of order k + 1 only adds the part of degree k of f(x) and its integral of degree k + 1
+	for(unsigned int k=0; k<order; ++k)
+	{
+		for(unsigned int j=0; j<nodes.size(); ++j)
+		{
+			Node & node = nodes[j];
+			Polynomial<DATA_TYPE> part;
+
+			switch(node.type)
+			{
+			case PICARD_CONST:
+				if(k == 0)
+				{
+					part = node.constant;
+				}
+				break;
+
+			case PICARD_VAR:
+				if(node.left < xParts.size())
+				{
+					part = xParts[node.left][k];
+				}
+				break;
+
+			case PICARD_PLUS:
+				part = nodes[node.left].parts[k] + nodes[node.right].parts[k];
+				break;
+
+			case PICARD_MINU:
+				part = nodes[node.left].parts[k] - nodes[node.right].parts[k];
+				break;
+
+			case PICARD_NEG:
+				part = nodes[node.left].parts[k];
+				part *= -1;
+				break;
+
+			case PICARD_MULT:
+				for(unsigned int l=0; l<=k; ++l)
+				{
+					part += nodes[node.left].parts[l] * nodes[node.right].parts[k - l];
+				}
+
+				part.cutoff(cutoff_threshold);
+				break;
+			}
+
+			node.parts.push_back(part);
+		}
+
+		for(unsigned int i=0; i<roots.size(); ++i)
+		{
+			Polynomial<DATA_TYPE> integral = nodes[roots[i]].parts[k];
+			integral.integral_time();
+			xParts[i][k + 1] += integral;
+		}
+	}
+
+	for(unsigned int i=0; i<x.tms.size(); ++i)
+	{
+		x.tms[i].expansion.clear();
+
+		for(unsigned int k=0; k<=order; ++k)
+		{
+			x.tms[i].expansion += xParts[i][k];
+		}
+
+		x.tms[i].remainder = 0;
+	}
+}
+
 }
 
 
@@ -16,6 +16,8 @@
 #include <sys/types.h>
 
 #include <cmath>
+#include <cfloat>
+#include <limits>
 #include <mpfr.h>
 #include <vector>
 #include <string>
@@ -29,6 +31,7 @@
 #include <map>
 #include <time.h>
 #include <algorithm>
+#include <utility>
 #include <gsl/gsl_poly.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_matrix.h>
@@ -49,6 +52,7 @@ const int high_precision	=	256;
 
 #define STOP_RATIO				0.99
 #define ABS_STOP_RATIO			0.99
+#define EXTRAPOLATION_SHARE		0.9			// the share of the predicted refinement gain an extrapolated remainder takes
 
 #define PN 						15 			// the number of digits printed
 #define INVALID 				-1e10
@@ -63,6 +67,13 @@ const int high_precision	=	256;
 #define LAMBDA_DOWN		0.5
 #define LAMBDA_UP		1.1
 
+#define STEP_TARGET_RATIO	0.5		// the ratio of a step's remainder to its estimation aimed at by the step size control
+#define STEP_SHRINK_MIN		0.2		// the bounds of the factor by which the step size control changes a step
+#define STEP_SHRINK_MAX		0.9
+#define STEP_GROW_MAX		2.0
+#define STEP_PI_ALPHA		0.7		// the exponents of the integral and the proportional parts of the step size control
+#define STEP_PI_BETA		0.4
+
 #define NAME_SIZE		100
 #define PRINT_SIZE		100
 
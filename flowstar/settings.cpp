@@ -16,6 +16,126 @@ Multivariate_Polynomial_Setting<Interval> multivariate_polynomial_setting;
 Expression_AST_Setting<Interval> expression_ast_setting;
 
 
+Stepsize_Controller::Stepsize_Controller()
+{
+	reset();
+}
+
+Stepsize_Controller::~Stepsize_Controller()
+{
+}
+
+void Stepsize_Controller::reset()
+{
+	exponent = 1;
+	last_step = 0;
+	last_ratio = 0;
+	accepted_ratio = STEP_TARGET_RATIO;
+	bRejected = false;
+}
+
+// returns the step size to try after a rejected one
+double Stepsize_Controller::reject(const double step, const double ratio, const unsigned int order)
+{
+	fit(step, ratio, order);
+	bRejected = true;
+
+	double factor = STEP_SHRINK_MIN;
+
+	if(ratio > 0)
+	{
+		factor = std::pow(STEP_TARGET_RATIO / ratio, 1 / exponent);
+	}
+
+	if(!(factor >= STEP_SHRINK_MIN))
+	{
+		factor = STEP_SHRINK_MIN;
+	}
+	else if(factor > STEP_SHRINK_MAX)
+	{
+		factor = STEP_SHRINK_MAX;
+	}
+
+	return step * factor;
+}
+
+void Stepsize_Controller::accept(const double step, const double ratio, const unsigned int order)
+{
+	fit(step, ratio, order);
+}
+
+// returns the step size to try after an accepted one, the integral part drives the error to STEP_TARGET_RATIO
+// and the proportional part damps its changes
+double Stepsize_Controller::next(const double step)
+{
+	double factor = STEP_GROW_MAX;
+
+	if(last_ratio > 0)
+	{
+		factor = std::pow(STEP_TARGET_RATIO / last_ratio, STEP_PI_ALPHA / exponent) * std::pow(accepted_ratio / STEP_TARGET_RATIO, STEP_PI_BETA / exponent);
+		accepted_ratio = last_ratio;
+	}
+
+	if(!(factor >= STEP_SHRINK_MIN))
+	{
+		factor = STEP_SHRINK_MIN;
+	}
+	else if(factor > STEP_GROW_MAX)
+	{
+		factor = STEP_GROW_MAX;
+	}
+
+	// do not grow right after a rejection
+	if(bRejected && factor > 1)
+	{
+		factor = 1;
+	}
+
+	bRejected = false;
+
+	return step * factor;
+}
+
+double Stepsize_Controller::ratio(const Interval & remainder, const Interval & estimation)
+{
+	double m = estimation.mag();
+
+	if(m > 0)
+	{
+		return remainder.mag() / m;
+	}
+	else
+	{
+		return remainder.mag() > 0 ? UNBOUNDED : 0;
+	}
+}
+
+void Stepsize_Controller::fit(const double step, const double ratio, const unsigned int order)
+{
+	if(last_ratio > 0 && ratio > 0 && (step > last_step * 1.01 || step < last_step * 0.99))
+	{
+		double p = std::log(ratio / last_ratio) / std::log(step / last_step);
+
+		if(!(p >= 1))
+		{
+			exponent = 1;
+		}
+		else if(p > order + 1)
+		{
+			exponent = order + 1;
+		}
+		else
+		{
+			exponent = p;
+		}
+	}
+
+	last_step = step;
+	last_ratio = ratio;
+}
+
+
+
 Taylor_Model_Computation_Setting::Taylor_Model_Computation_Setting()
 {
 	order = 0;
@@ -69,6 +189,9 @@ Taylor_Model_Computation_Setting::Taylor_Model_Computation_Setting(const Taylor_
 	order_max			= setting.order_max;
 
 	queue_size			= setting.queue_size;
+
+	refinement_tolerance	= setting.refinement_tolerance;
+	step_controller			= setting.step_controller;
 }
 
 Taylor_Model_Computation_Setting::~Taylor_Model_Computation_Setting()
@@ -96,6 +219,9 @@ Taylor_Model_Computation_Setting & Taylor_Model_Computation_Setting::operator =
 
 	queue_size			= setting.queue_size;
 
+	refinement_tolerance	= setting.refinement_tolerance;
+	step_controller			= setting.step_controller;
+
 	return *this;
 }
 
@@ -246,6 +372,11 @@ void Taylor_Model_Computation_Setting::setQueueSize(const unsigned int m)
 	queue_size = m;
 }
 
+void Taylor_Model_Computation_Setting::setRefinementTolerance(const std::vector<double> & tolerance)
+{
+	refinement_tolerance = tolerance;
+}
+
 void Taylor_Model_Computation_Setting::clear()
 {
 	order = 0;
@@ -201,6 +201,37 @@ UTM_Setting<DATA_TYPE> & UTM_Setting<DATA_TYPE>::operator = (const UTM_Setting<D
 
 
 
+// The step size control of the adaptive integration. The error of a step is the largest ratio of the magnitude of a
+// remainder to that of its estimation, which has to stay below 1 for the step to be accepted. It is modeled as
+// c * step^exponent, where the exponent is fitted to the last two trials and lies between 1, if the linear part of
+// the Picard operator dominates, and order + 1, if the truncation error does.
+class Stepsize_Controller
+{
+public:
+	double exponent;
+	double last_step;			// the step size of the last trial
+	double last_ratio;			// the error of the last trial, 0 if it is unknown
+	double accepted_ratio;		// the error of the step accepted before the last trial
+	bool bRejected;				// the current step has been rejected
+
+public:
+	Stepsize_Controller();
+	~Stepsize_Controller();
+
+	void reset();
+
+	double reject(const double step, const double ratio, const unsigned int order);
+	void accept(const double step, const double ratio, const unsigned int order);
+	double next(const double step);
+
+	static double ratio(const Interval & remainder, const Interval & estimation);
+
+protected:
+	void fit(const double step, const double ratio, const unsigned int order);
+};
+
+
+
 class Taylor_Model_Computation_Setting
 {
 public:
@@ -220,6 +251,10 @@ public:
 
 	unsigned int queue_size;
 
+	std::vector<double> refinement_tolerance;	// the remainder refinement of a dimension stops if its predicted gain is below it
+
+	Stepsize_Controller step_controller;
+
 public:
 	Taylor_Model_Computation_Setting();
 	Taylor_Model_Computation_Setting(const Variables & vars);
@@ -240,6 +275,7 @@ public:
 	void setRemainderEstimation(const std::vector<Interval> & intVec);
 	void setDomain(const std::vector<Interval> & intVec);
 	void setQueueSize(const unsigned int m);
+	void setRefinementTolerance(const std::vector<double> & tolerance);
 
 	void clear();
 
@@ -1,9 +1,28 @@
+#include <map>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 #include <set>
 #include <queue>
+#include <unordered_map>
+#include <fcntl.h>
+#include <dirent.h>
+#include <signal.h>
+#include <unistd.h>
+#include <poll.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <algorithm>
 #include <boost/dynamic_bitset.hpp>
 
 #include "Continuous.h"
-#include "gnuplot-iostream.h"
+#include "result.h"
 
 using namespace boost;
 using namespace std;
@@ -29,6 +48,10 @@ int order = 6;
 double eps = 1e-10;
 int queueSize = 1000;
 Interval I(-0.01, 0.01);  // remainder estimation
+double refineTolerance = 0;  // fraction of the finest cell width over the K-step horizon, 0: refine the remainders while they contract
+bool adaptiveStepMode = false;  // adaptive steps instead of the step size of the model
+const int stepRange = 16;  // the adaptive steps range from the step size of the model / stepRange
+const int stepGrowth = 4;  // to the step size of the model * stepGrowth, longer steps lose safe cells on example/model3
 Computational_Setting setting;
 Deterministic_Continuous_Dynamics dynamics({});
 
@@ -38,17 +61,186 @@ vector<vector<vector<int>>> oneStepGraph;  // [start][meet] 0: not meet, 1: meet
 vector<vector<int>> revKStepGraph;
 dynamic_bitset<> Ts, Tk, Ti;
 
-void parseModel(char* modelPath) {
+// Symmetry
+bool symmetryMode = true;
+vector<vector<int>> symmetries;  // sign of every state dimension, the first one is the identity
+
+// Verdict-only mode
+bool verdictMode = false;
+dynamic_bitset<> oneStepDone;
+unordered_map<long long, vector<int>> kStepMemo;  // (id, steps, miss) -> reachable grids, empty: unsafe
+
+// Adaptive refinement
+struct GridNode {
+    vector<Interval> box;
+    int gridId;  // -1: split into 2^xcnt children
+    int child;  // first child node
+    int depth;
+};
+bool adaptiveMode = false;
+int maxDepth = 3;
+double timeLimit = 0;  // wall-clock seconds, 0: unlimited
+vector<GridNode> gridTree;  // the first countGrids() nodes are the uniform grids
+vector<int> gridNode;  // grid -> node
+vector<vector<vector<Interval>>> reachBoxes;  // [grid][meet], empty: unsafe
+dynamic_bitset<> reachDone;
+
+// Multi-resolution reuse
+bool multiResMode = false;
+const string resultDir = "./results/";
+string modelKey;  // everything the reachable boxes depend on, except the grid count
+dynamic_bitset<> integrated;  // the reachable box is computed from the grid itself, not inherited
+
+// Comparison of the reachable boxes with and without sweeping the rounding errors
+bool compareSweepMode = false;
+const double sweepWidthBound = 1e-6;  // the largest relative widening of a reachable box accepted by --compare-sweep
+
+// Tiered precision
+bool tieredMode = false;
+vector<pair<int, double>> tiers;  // (order, step size), from the cheapest one
+vector<int> gridTier;  // the tier of the reachable boxes of every grid
+
+// Persistent cell cache
+bool cacheMode = false;
+string cacheDir;  // empty: $XDG_CACHE_HOME/saw/, or ~/.cache/saw/ without it
+long long cacheSizeLimit = 1LL << 30;  // bytes of all the cache files, the least recently used ones are removed beyond it
+string settingKey;  // order and step size of the current setting
+int cacheFd = -1;  // -1: no cache, or the cache can not be written
+mutex cacheMutex;  // flock does not exclude the threads of this process
+const char *cacheMap = NULL;
+size_t cacheMapSize = 0;
+unordered_map<unsigned long long, const char *> cacheIndex;  // key -> record in cacheMap
+
+// Checkpoint of the one-step graph
+bool checkpointMode = false;  // log the edges while they are built, the log of an unsharded run is removed once it completes
+bool resumeMode = false;
+const int syncInterval = 5;  // seconds between two fsync
+FILE *checkpointFile = NULL;
+time_t lastSync;
+
+// Sharded build
+const int edgeLogMagic = 0x47574153;  // "SAWG"
+int shardId = 0, shardCnt = 1;  // this process builds the shardId-th of shardCnt slices of the grids
+bool mergeMode = false;
+
+// Binary result file
+bool loadMode = false;
+long loadedEdges[2];  // the one-step and K-step edges of the loaded file, --load only reads the regions
+
+// Daemon mode
+bool serveMode = false;
+const char *socketPath = NULL;  // NULL: jobs from stdin
+int jobCnt = 0;  // concurrent jobs, 0: one per processor
+string outputPath = "output.svg";
+int jobResult = 0;  // exit status of a served job, 1: safe, 2: unsafe
+
+// Run report
+enum {PHASE_PARSE, PHASE_FLOWSTAR, PHASE_GRIDS, PHASE_ONE_STEP, PHASE_K_STEP, PHASE_CLOSED, PHASE_CHECK, PHASE_PLOT, PHASE_CNT};
+const char *phaseNames[PHASE_CNT] = {"parse", "flowstar", "grids", "one_step", "k_step", "closed_subgraph", "check", "plot"};
+string reportPath;  // empty: no report, *.csv: one row appended per run, otherwise JSON
+string reportModel;
+double phaseWall[PHASE_CNT], phaseCpu[PHASE_CNT];
+int currentPhase = -1;
+double phaseMarkWall, phaseMarkCpu;
+long flowpipeCnt = 0, cacheHitCnt = 0;
+
+double getTime(clockid_t clock) {
+    timespec now;
+    clock_gettime(clock, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// Charges the time since the last switch to the current phase. Phases are exclusive:
+// a nested phase pauses the outer one.
+void switchPhase(int phase) {
+    double wall = getTime(CLOCK_MONOTONIC), cpu = getTime(CLOCK_PROCESS_CPUTIME_ID);
+    if (currentPhase >= 0) {
+        phaseWall[currentPhase] += wall - phaseMarkWall;
+        phaseCpu[currentPhase] += cpu - phaseMarkCpu;
+    }
+    currentPhase = phase;
+    phaseMarkWall = wall;
+    phaseMarkCpu = cpu;
+}
+
+struct PhaseTimer {
+    int previous;
+    PhaseTimer(int phase): previous(currentPhase) { switchPhase(phase); }
+    ~PhaseTimer() { switchPhase(previous); }
+};
+
+// Progress, workers only bump the counter and one reporter thread prints it a few times a second.
+const double progressInterval = 0.5;  // seconds
+const char *progressLabel;
+long progressTotal;  // 0: unknown, only the count is printed
+atomic<long> progressDone(0);
+double progressBegin;
+bool progressRunning = false;
+thread progressThread;
+mutex progressMutex;
+condition_variable progressStop;
+
+void printProgress() {
+    long done = progressDone;
+    double elapsed = getTime(CLOCK_MONOTONIC) - progressBegin;
+    double rate = elapsed > 0 ? done / elapsed : 0;
+    if (progressTotal > 0) {
+        printf("\r       %s: %.2f%%, %.1f/s", progressLabel, 100.0 * done / progressTotal, rate);
+        if (rate > 0) {
+            int eta = (progressTotal - done) / rate;
+            printf(", ETA %d:%02d:%02d", eta / 3600, eta / 60 % 60, eta % 60);
+        }
+    } else {
+        printf("\r       %s: %ld, %.1f/s", progressLabel, done, rate);
+    }
+    printf("\033[K");  // clear the rest of a longer previous line
+    fflush(stdout);
+}
+
+// Nothing is printed when stdout is not a terminal, e.g. the log of a served job.
+void startProgress(const char *label, long total) {
+    progressLabel = label;
+    progressTotal = total;
+    progressDone = 0;
+    progressBegin = getTime(CLOCK_MONOTONIC);
+    progressRunning = isatty(STDOUT_FILENO);
+    if (!progressRunning) return;
+    progressThread = thread([]() {
+        unique_lock<mutex> lock(progressMutex);
+        while (!progressStop.wait_for(lock, chrono::duration<double>(progressInterval), []() { return !progressRunning; })) {
+            printProgress();
+        }
+    });
+}
+
+void stopProgress() {
+    if (!progressRunning) return;
+    {
+        lock_guard<mutex> lock(progressMutex);
+        progressRunning = false;
+    }
+    progressStop.notify_one();
+    progressThread.join();
+    printProgress();
+    printf("\n");
+}
+
+bool parseModel(char* modelPath) {
+    PhaseTimer timer(PHASE_PARSE);
     printf("[Info] Parsing model.\n");
-    FILE *file = fopen(modelPath, "r");
+    FILE *file = modelPath ? fopen(modelPath, "r") : NULL;
+    if (!file) {
+        printf("[Error] Can not open the model %s.\n", modelPath ? modelPath : "(none)");
+        return false;
+    }
     fscanf(file, "%d%d%d", &xcnt, &ucnt, &d);
     for (int i = 0; i < xcnt; i++) {
-        fscanf(file, "%s", buf);
+        fscanf(file, "%255s", buf);
         xname.push_back(buf);
         stateVars.declareVar(buf);
     }
     for (int i = 0; i < ucnt; i++) {
-        fscanf(file, "%s", buf);
+        fscanf(file, "%255s", buf);
         uname.push_back(buf);
         stateVars.declareVar(buf);
     }
@@ -56,10 +248,12 @@ void parseModel(char* modelPath) {
     for (int i = 0; i < xcnt; i++) {
         fgets(buf, BUFSIZE, file);
         xexpr.push_back(Expression_AST<Real>(buf));
+        modelKey += buf;
     }
     for (int i = 0; i < ucnt; i++) {
         fgets(buf, BUFSIZE, file);
         uexpr.push_back(Expression_AST<Real>(buf));
+        modelKey += buf;
     }
     fscanf(file, "%lf%lf", &period, &stepSize);
     fscanf(file, "%d%d", &m, &k);
@@ -68,24 +262,79 @@ void parseModel(char* modelPath) {
         fscanf(file, "%lf%lf", &start, &end);
         safeStateInterval.push_back({start, end});
     }
+    for (string &name: xname) {
+        modelKey += name + " ";
+    }
+    for (string &name: uname) {
+        modelKey += name + " ";
+    }
+    sprintf(buf, "%.17g %.17g\n", period, stepSize);
+    modelKey += buf;
+    for (int i = 0; i < xcnt; i++) {
+        sprintf(buf, "%.17g %.17g\n", safeStateInterval[i].inf(), safeStateInterval[i].sup());
+        modelKey += buf;
+    }
     for (int i = 0; i < xcnt; i++) {
         double start, end;
         fscanf(file, "%lf%lf", &start, &end);
         initialStateInterval.push_back({start, end});
     }
     fclose(file);
+    return true;
 }
 
-void buildFlowstar() {
+bool buildFlowstar() {
+    PhaseTimer timer(PHASE_FLOWSTAR);
     printf("[Info] Building FLOW* configuration.\n");
     FILE *file = fopen("config.txt", "r");
+    if (!file) {
+        printf("[Error] Can not open config.txt.\n");
+        return false;
+    }
     fscanf(file, "%d", &order);
     fscanf(file, "%lf", &eps);
     fscanf(file, "%d", &queueSize);
     double start, end;
     fscanf(file, "%lf%lf", &start, &end);
     I = Interval(start, end);
-    setting.setFixedStepsize(stepSize, order);  // stepsize and order for reachability analysis
+    sprintf(buf, "%d %.17g %d %.17g %.17g\n", order, eps, queueSize, start, end);
+    modelKey += buf;
+    if (roundingErrorSweep) {
+        modelKey += "sweep rounding\n";
+    }
+    if (refineTolerance > 0) {
+        // The remainders of every step of the K-step horizon add up, so each step gets an equal share of the
+        // fraction of the cell width, with the smallest step size any mode may take.
+        double minStep = stepSize;
+        if (tieredMode) {
+            minStep = stepSize / 2;
+        } else if (adaptiveStepMode && !roundingErrorSweep) {
+            minStep = stepSize / stepRange;
+        }
+        double horizonSteps = ceil(period / minStep - 1e-9) * k;
+        vector<double> tolerance(stateVars.size(), 0);
+        for (int i = 0; i < xcnt; i++) {
+            double cellWidth = (safeStateInterval[i].sup() - safeStateInterval[i].inf()) / d;
+            if (adaptiveMode) {
+                cellWidth /= 1 << maxDepth;
+            }
+            tolerance[i] = refineTolerance * cellWidth / horizonSteps;
+            sprintf(buf, "refine %.17g\n", tolerance[i]);
+            modelKey += buf;
+        }
+        setting.setRefinementTolerance(tolerance);
+    }
+    // The tiers set their own fixed step sizes, and only the fixed steps sweep the rounding errors.
+    if (adaptiveStepMode && !tieredMode && !roundingErrorSweep) {
+        // longer steps where the remainders allow it, smaller steps where they do not
+        setting.setAdaptiveStepsize(stepSize / stepRange, min(period, stepSize * stepGrowth), order);
+        sprintf(buf, "adaptive step %d %d\n", stepRange, stepGrowth);
+        modelKey += buf;
+    } else {
+        setting.setFixedStepsize(stepSize, order);  // stepsize and order for reachability analysis
+    }
+    sprintf(buf, "%d %.17g\n", order, stepSize);
+    settingKey = buf;
     setting.setTime(period);  // time horizon for a single control step
     setting.setCutoffThreshold(eps);  // cutoff threshold
     setting.setQueueSize(queueSize);  // queue size for the symbolic remainder
@@ -102,13 +351,11 @@ void buildFlowstar() {
     }
     dynamics = Deterministic_Continuous_Dynamics(ode);
     fclose(file);
+    return true;
 }
 
 vector<Interval> curInt;
-void buildGrids(int curDim=0) {
-    if (curDim == 0) {
-        printf("[Info] Building grids.\n");    
-    }
+void addGrids(int curDim) {
     if (curDim == xcnt) {
         grids.push_back(curInt);
         return;
@@ -118,11 +365,37 @@ void buildGrids(int curDim=0) {
         double start = safeStateInterval[curDim].inf() + i * blockSize;
         double end = safeStateInterval[curDim].inf() + (i + 1) * blockSize;
         curInt.push_back(Interval(start, end));
-        buildGrids(curDim + 1);
+        addGrids(curDim + 1);
         curInt.pop_back();
     }
 }
 
+void buildGrids() {
+    PhaseTimer timer(PHASE_GRIDS);
+    printf("[Info] Building grids.\n");
+    addGrids(0);
+}
+
+int countGrids() {
+    int n = 1;
+    for (int i = 0; i < xcnt; i++) {
+        n *= d;
+    }
+    return n;
+}
+
+void getGrid(int id, vector<Interval> &grid) {
+    grid.resize(xcnt);
+    for (int curDim = xcnt - 1; curDim >= 0; curDim--) {
+        int i = id % d;
+        id /= d;
+        double blockSize = (safeStateInterval[curDim].sup() - safeStateInterval[curDim].inf()) / d;
+        double start = safeStateInterval[curDim].inf() + i * blockSize;
+        double end = safeStateInterval[curDim].inf() + (i + 1) * blockSize;
+        grid[curDim] = Interval(start, end);
+    }
+}
+
 void getIntersectGridsId(int curDim, int curId, vector<Interval> &region, vector<int> &gridsId) {
     if (curDim == xcnt) {
         gridsId.push_back(curId);
@@ -139,66 +412,557 @@ void getIntersectGridsId(int curDim, int curId, vector<Interval> &region, vector
     }
 }
 
+unsigned long long fnv1a(const char *data, size_t size, unsigned long long hash=14695981039346656037ULL) {  // FNV-1a
+    for (size_t i = 0; i < size; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+unsigned long long modelHash() {
+    return fnv1a(modelKey.data(), modelKey.size());
+}
+
+// record: key, meet, safe, grid bounds, reachable box bounds, checksum of the previous fields
+size_t cacheRecordSize() {
+    return sizeof(unsigned long long) + 2 * sizeof(int) + 4 * xcnt * sizeof(double) + sizeof(unsigned long long);
+}
+
+unsigned long long cacheKey(vector<Interval> &grid, int meet) {
+    string key = modelKey + settingKey;
+    for (Interval &dim: grid) {
+        sprintf(buf, "%.17g %.17g\n", dim.inf(), dim.sup());
+        key += buf;
+    }
+    key += meet ? "meet" : "miss";
+    return fnv1a(key.data(), key.size());
+}
+
+string defaultCacheDir() {
+    const char *xdg = getenv("XDG_CACHE_HOME");
+    if (xdg && *xdg) {
+        return string(xdg) + "/saw/";
+    }
+    const char *home = getenv("HOME");
+    return string(home ? home : ".") + "/.cache/saw/";
+}
+
+// Creates the directory and its missing parents.
+void makeDirs(const string &path) {
+    for (size_t i = 1; i <= path.size(); i++) {
+        if (i == path.size() || path[i] == '/') {
+            mkdir(path.substr(0, i).c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+        }
+    }
+}
+
+// Removes the least recently used cache files of the other models until all of them fit in cacheSizeLimit.
+void evictCache(const string &keep) {
+    DIR *dir = opendir(cacheDir.c_str());
+    if (!dir) {
+        return;
+    }
+    vector<pair<time_t, string>> files;  // (last use, path)
+    long long total = 0;
+    while (dirent *entry = readdir(dir)) {
+        string name = entry->d_name;
+        struct stat st;
+        if (name.size() < 6 || name.compare(name.size() - 6, 6, ".cells") || stat((cacheDir + name).c_str(), &st)) {
+            continue;
+        }
+        total += st.st_size;
+        if (cacheDir + name != keep) {
+            files.push_back({st.st_mtime, cacheDir + name});
+        }
+    }
+    closedir(dir);
+    sort(files.begin(), files.end());
+    for (auto &file: files) {
+        struct stat st;
+        if (total <= cacheSizeLimit) break;
+        if (!stat(file.second.c_str(), &st) && !unlink(file.second.c_str())) {
+            total -= st.st_size;
+        }
+    }
+}
+
+// One append-only file per model, shared by every process through flock.
+void openCache() {
+    if (!cacheMode || loadMode || mergeMode) {
+        return;
+    }
+    if (cacheDir.empty()) {
+        cacheDir = defaultCacheDir();
+    }
+    makeDirs(cacheDir);
+    sprintf(buf, "%s%016llx.cells", cacheDir.c_str(), modelHash());
+    string path = buf;
+    cacheFd = open(path.c_str(), O_RDWR | O_APPEND | O_CREAT, 0644);
+    if (cacheFd < 0) {
+        printf("[Warning] Can not open the cache %s.\n", path.c_str());
+        return;
+    }
+    futimens(cacheFd, NULL);  // the last use, for the eviction
+    evictCache(path);
+    struct stat st;
+    fstat(cacheFd, &st);
+    cacheMapSize = st.st_size;
+    if (cacheMapSize == 0) {
+        return;
+    }
+    void *map = mmap(NULL, cacheMapSize, PROT_READ, MAP_SHARED, cacheFd, 0);
+    if (map == MAP_FAILED) {
+        cacheMapSize = 0;
+        return;
+    }
+    cacheMap = (const char *)map;
+    // A record torn by a killed process fails its checksum and is skipped.
+    size_t recordSize = cacheRecordSize();
+    size_t bodySize = recordSize - sizeof(unsigned long long);
+    for (size_t offset = 0; offset + recordSize <= cacheMapSize; offset += recordSize) {
+        const char *record = cacheMap + offset;
+        unsigned long long checksum;
+        memcpy(&checksum, record + bodySize, sizeof(checksum));
+        if (checksum != fnv1a(record, bodySize)) continue;
+        unsigned long long key;
+        memcpy(&key, record, sizeof(key));
+        cacheIndex[key] = record;
+    }
+    printf("[Info] Found %d cached flowpipes.\n", (int)cacheIndex.size());
+}
+
+bool lookupCache(vector<Interval> &grid, int meet, vector<Interval> &reachableState, bool &safe) {
+    auto it = cacheIndex.find(cacheKey(grid, meet));
+    if (it == cacheIndex.end()) {
+        return false;
+    }
+    const char *record = it->second + sizeof(unsigned long long);
+    int flags[2];
+    memcpy(flags, record, sizeof(flags));
+    vector<double> bounds(4 * xcnt);
+    memcpy(bounds.data(), record + sizeof(flags), bounds.size() * sizeof(double));
+    if (flags[0] != meet) {
+        return false;
+    }
+    for (int i = 0; i < xcnt; i++) {
+        if (bounds[2 * i] != grid[i].inf() || bounds[2 * i + 1] != grid[i].sup()) {
+            return false;
+        }
+    }
+    safe = flags[1];
+    reachableState.resize(xcnt);
+    for (int i = 0; i < xcnt; i++) {
+        reachableState[i] = Interval(bounds[2 * xcnt + 2 * i], bounds[2 * xcnt + 2 * i + 1]);
+    }
+    return true;
+}
+
+void storeCache(vector<Interval> &grid, int meet, vector<Interval> &reachableState, bool safe) {
+    size_t recordSize = cacheRecordSize();
+    vector<char> record(recordSize);
+    unsigned long long key = cacheKey(grid, meet);
+    int flags[2] = {meet, safe};
+    vector<double> bounds;
+    for (Interval &dim: grid) {
+        bounds.push_back(dim.inf());
+        bounds.push_back(dim.sup());
+    }
+    for (Interval &dim: reachableState) {
+        bounds.push_back(dim.inf());
+        bounds.push_back(dim.sup());
+    }
+    char *p = record.data();
+    memcpy(p, &key, sizeof(key));
+    memcpy(p + sizeof(key), flags, sizeof(flags));
+    memcpy(p + sizeof(key) + sizeof(flags), bounds.data(), bounds.size() * sizeof(double));
+    unsigned long long checksum = fnv1a(p, recordSize - sizeof(checksum));
+    memcpy(p + recordSize - sizeof(checksum), &checksum, sizeof(checksum));
+
+    // Cut a torn tail first, so the records stay aligned.
+    lock_guard<mutex> lock(cacheMutex);
+    if (cacheFd < 0) {
+        return;
+    }
+    flock(cacheFd, LOCK_EX);
+    struct stat st;
+    bool stored = !fstat(cacheFd, &st);
+    if (stored && st.st_size % recordSize) {
+        stored = !ftruncate(cacheFd, st.st_size - st.st_size % recordSize);
+    }
+    bool full = stored && st.st_size + (long long)recordSize > cacheSizeLimit;
+    stored = stored && !full && write(cacheFd, p, recordSize) == (ssize_t)recordSize;
+    if (full) {
+        printf("[Warning] The cache of the model reached the size limit, it is read only from now on.\n");
+    } else if (!stored) {
+        // Drop a partly written record, and stop writing, e.g. on a full disk.
+        if (!fstat(cacheFd, &st) && st.st_size % recordSize) {
+            ftruncate(cacheFd, st.st_size - st.st_size % recordSize);
+        }
+        printf("[Warning] Can not write the cache, it is read only from now on.\n");
+    }
+    flock(cacheFd, LOCK_UN);
+    if (!stored) {
+        close(cacheFd);
+        cacheFd = -1;
+    }
+}
+
+// Integrates the grid over one period, returns false if the flowpipe stops before the end of it.
+bool integrateGrid(vector<Interval> &grid, int meet, vector<Interval> &reachableState) {
+    // The initial set is same as the current grid
+    vector<Interval> initialState = grid;
+    for (int i = 0; i < ucnt; i++) {
+        initialState.push_back(Interval(0));
+    }
+    Flowpipe initial_set(initialState);
+    Result_of_Reachability result;
+
+    // Calculate the input if it meets the deadline.
+    if (meet) {
+        for (int i = 0; i < ucnt; i++) {
+            TaylorModel<Real> tm_u;
+            uexpr[i].evaluate(tm_u, initial_set.tmvPre.tms, setting.tm_setting.order, initial_set.domain, setting.tm_setting.cutoff_threshold, setting.g_setting);
+            initial_set.tmvPre.tms[xcnt + i] = tm_u;    
+        }
+    }
+
+    // Move forward one step
+    vector<Constraint> unsafeSet;
+    dynamics.reach_end_of_time(result, setting, initial_set, unsafeSet);
+    if (result.status != COMPLETED_SAFE || result.fp_end_of_time.tmvPre.tms.empty()) {
+        reachableState.clear();
+        return false;
+    }
+    result.fp_end_of_time.intEval(reachableState, setting.tm_setting.order, setting.tm_setting.cutoff_threshold);
+    reachableState.resize(xcnt);  // drop the inputs
+    return true;
+}
+
+bool buildReachableState(vector<Interval> &grid, int meet, vector<Interval> &reachableState) {
+    bool safe = true;
+    if (lookupCache(grid, meet, reachableState, safe)) {
+        cacheHitCnt++;
+        return safe;
+    }
+    flowpipeCnt++;
+    if (!integrateGrid(grid, meet, reachableState)) {
+        // The flowpipe stops before the end of the period, so the grid may reach anywhere.
+        // Not cached, a later run may succeed with other settings.
+        return false;
+    }
+
+    // Check safety and build edge
+    for (int i = 0; i < xcnt; i++) {
+        double segLen = reachableState[i].width();
+        double inLen = reachableState[i].intersect(safeStateInterval[i]).width();
+        if (abs(segLen - inLen) > eps) {
+            safe = false;
+        }
+    }
+    storeCache(grid, meet, reachableState, safe);
+    return safe;
+}
+
+void detectSymmetry() {
+    symmetries.assign(1, vector<int>(xcnt, 1));
+    if (!symmetryMode) {
+        return;
+    }
+    for (int mask = 1; mask < (1 << xcnt); mask++) {
+        vector<int> signs(xcnt + ucnt, 1);
+        bool valid = true;
+        for (int i = 0; i < xcnt; i++) {
+            if (mask >> i & 1) {
+                signs[i] = -1;
+                // The grids must be mirrored onto themselves.
+                valid = valid && safeStateInterval[i].inf() == -safeStateInterval[i].sup();
+            }
+        }
+        // An even control law keeps the input, an odd one negates it.
+        for (int i = 0; valid && i < ucnt; i++) {
+            int parity = uexpr[i].parity(signs);
+            if (parity & PARITY_EVEN) {
+                signs[xcnt + i] = 1;
+            } else if (parity & PARITY_ODD) {
+                signs[xcnt + i] = -1;
+            } else {
+                valid = false;
+            }
+        }
+        for (int i = 0; valid && i < xcnt; i++) {
+            valid = xexpr[i].parity(signs) & (signs[i] > 0 ? PARITY_EVEN : PARITY_ODD);
+        }
+        if (valid) {
+            signs.resize(xcnt);
+            symmetries.push_back(signs);
+        }
+    }
+    // The composition of two symmetries is also a symmetry.
+    for (int a = 0; a < symmetries.size(); a++) {
+        for (int b = 0; b < a; b++) {
+            vector<int> signs(xcnt);
+            for (int i = 0; i < xcnt; i++) {
+                signs[i] = symmetries[a][i] * symmetries[b][i];
+            }
+            if (find(symmetries.begin(), symmetries.end(), signs) == symmetries.end()) {
+                symmetries.push_back(signs);
+            }
+        }
+    }
+    if (symmetries.size() > 1) {
+        printf("[Info] Found %d symmetries of the system.\n", (int)symmetries.size() - 1);
+    }
+}
+
+int mirrorGridId(int id, vector<int> &signs) {
+    int mirrored = 0, base = 1;
+    for (int i = xcnt - 1; i >= 0; i--) {
+        int index = id % d;
+        id /= d;
+        if (signs[i] < 0) {
+            index = d - 1 - index;
+        }
+        mirrored += index * base;
+        base *= d;
+    }
+    return mirrored;
+}
+
+void mirrorBox(vector<Interval> &box, vector<int> &signs) {
+    for (int i = 0; i < xcnt; i++) {
+        if (signs[i] < 0) {
+            box[i] = Interval(-box[i].sup(), -box[i].inf());
+        }
+    }
+}
+
+int getSymmetryRepresentative(int id) {
+    int representative = id;
+    for (auto &signs: symmetries) {
+        representative = min(representative, mirrorGridId(id, signs));
+    }
+    return representative;
+}
+
+// Mirrored grids share one flowpipe, computed from the hull of their boxes mirrored onto the start grid.
+void buildSymmetricOneStepEdges(int start, int meet) {
+    PhaseTimer timer(PHASE_ONE_STEP);
+    vector<Interval> box;
+    getGrid(start, box);
+    for (auto &signs: symmetries) {
+        vector<Interval> mirrored;
+        getGrid(mirrorGridId(start, signs), mirrored);
+        mirrorBox(mirrored, signs);
+        for (int i = 0; i < xcnt; i++) {
+            box[i].hull_assign(mirrored[i]);
+        }
+    }
+    vector<Interval> reachableState;
+    bool safe = buildReachableState(box, meet, reachableState);
+    for (auto &signs: symmetries) {
+        int id = mirrorGridId(start, signs);
+        oneStepGraph[id].resize(2);
+        oneStepGraph[id][meet].clear();
+        if (safe) {
+            vector<Interval> mirrored = reachableState;
+            mirrorBox(mirrored, signs);
+            getIntersectGridsId(0, 0, mirrored, oneStepGraph[id][meet]);
+        }
+    }
+}
+
+string checkpointPath() {
+    if (shardCnt > 1) {
+        sprintf(buf, "%s%016llx_%d_%dof%d.log", resultDir.c_str(), modelHash(), d, shardId, shardCnt);
+    } else {
+        sprintf(buf, "%s%016llx_%d.log", resultDir.c_str(), modelHash(), d);
+    }
+    return buf;
+}
+
+// header: magic, xcnt, d, shard id, shard count, model hash
+// record: id, meet, edge count, edges, checksum of the previous fields
+void writeEdgeLogHeader(FILE *file) {
+    int header[5] = {edgeLogMagic, xcnt, d, shardId, shardCnt};
+    unsigned long long hash = modelHash();
+    fwrite(header, sizeof(int), 5, file);
+    fwrite(&hash, sizeof(hash), 1, file);
+}
+
+// Returns the number of valid records, -1 if the log belongs to another model.
+int readEdgeLog(FILE *file, dynamic_bitset<> *done, long &valid) {
+    int header[5];
+    unsigned long long hash;
+    if (fread(header, sizeof(int), 5, file) != 5 || fread(&hash, sizeof(hash), 1, file) != 1) {
+        return -1;
+    }
+    if (header[0] != edgeLogMagic || header[1] != xcnt || header[2] != d || hash != modelHash()) {
+        return -1;
+    }
+    valid = ftell(file);
+    int cnt = 0;
+    while (true) {
+        int record[3];
+        if (fread(record, sizeof(int), 3, file) != 3) break;
+        int id = record[0], meet = record[1];
+        if (id < 0 || id >= grids.size() || meet < 0 || meet > 1 || record[2] < 0 || record[2] > grids.size()) break;
+        vector<int> edges(record[2]);
+        unsigned long long checksum;
+        if (fread(edges.data(), sizeof(int), edges.size(), file) != edges.size()) break;
+        if (fread(&checksum, sizeof(checksum), 1, file) != 1) break;
+        unsigned long long recordHash = fnv1a((const char *)record, sizeof(record));
+        if (checksum != fnv1a((const char *)edges.data(), edges.size() * sizeof(int), recordHash)) break;
+        oneStepGraph[id][meet] = edges;
+        done[meet].set(id);
+        valid = ftell(file);
+        cnt++;
+    }
+    return cnt;
+}
+
+// Only a shard, --checkpoint or --resume log the edges.
+void openCheckpoint(dynamic_bitset<> *done) {
+    if (!checkpointMode && !resumeMode && shardCnt == 1) {
+        return;
+    }
+    mkdir(resultDir.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    string path = checkpointPath();
+    lastSync = time(NULL);
+    if (resumeMode && (checkpointFile = fopen(path.c_str(), "r+b"))) {
+        long valid = 0;
+        int cnt = readEdgeLog(checkpointFile, done, valid);
+        if (cnt >= 0) {
+            // Drop the record torn by the killed run.
+            ftruncate(fileno(checkpointFile), valid);
+            fseek(checkpointFile, valid, SEEK_SET);
+            printf("[Info] Resuming from %d checkpointed edge lists.\n", cnt);
+            return;
+        }
+        fclose(checkpointFile);
+    }
+    checkpointFile = fopen(path.c_str(), "wb");
+    if (!checkpointFile) {
+        printf("[Warning] Can not write the checkpoint to %s.\n", path.c_str());
+        return;
+    }
+    writeEdgeLogHeader(checkpointFile);
+}
+
+void writeCheckpoint(int id, int meet) {
+    if (!checkpointFile) {
+        return;
+    }
+    vector<int> &edges = oneStepGraph[id][meet];
+    int record[3] = {id, meet, (int)edges.size()};
+    unsigned long long checksum = fnv1a((const char *)record, sizeof(record));
+    checksum = fnv1a((const char *)edges.data(), edges.size() * sizeof(int), checksum);
+    fwrite(record, sizeof(int), 3, checkpointFile);
+    fwrite(edges.data(), sizeof(int), edges.size(), checkpointFile);
+    fwrite(&checksum, sizeof(checksum), 1, checkpointFile);
+    if (time(NULL) - lastSync >= syncInterval) {
+        fflush(checkpointFile);
+        fsync(fileno(checkpointFile));
+        lastSync = time(NULL);
+    }
+}
+
+void closeCheckpoint() {
+    if (!checkpointFile) {
+        return;
+    }
+    fflush(checkpointFile);
+    fsync(fileno(checkpointFile));
+    fclose(checkpointFile);
+    checkpointFile = NULL;
+}
+
 void buildOneStepGraph() {
+    PhaseTimer timer(PHASE_ONE_STEP);
     printf("[Info] Building one-step graph.\n");
-    int process = 0;
     int edgeCnt = 0;
-    oneStepGraph.resize(grids.size());
-    // #pragma omp parallel for reduction(+:edgeCnt) num_threads(4)
+    oneStepGraph.assign(grids.size(), vector<vector<int>>(2));
+    dynamic_bitset<> done[2] = {dynamic_bitset<>(grids.size()), dynamic_bitset<>(grids.size())};
+    openCheckpoint(done);
+    vector<int> starts;
     for (int start = 0; start < grids.size(); start++) {
-        oneStepGraph[start].resize(2);
+        if (getSymmetryRepresentative(start) == start) {
+            starts.push_back(start);
+        }
+    }
+    long long startCnt = starts.size();
+    starts = vector<int>(starts.begin() + startCnt * shardId / shardCnt, starts.begin() + startCnt * (shardId + 1) / shardCnt);
+    startProgress("Process", starts.size() * 2);
+    // #pragma omp parallel for reduction(+:edgeCnt) num_threads(4)
+    for (int start: starts) {
         for (int meet = 0; meet < 2; meet++) {
-            // #pragma omp critical
-            {
-                process += 1;
-                printf("\r       Process: %.2f%%", 100.0 * process / (grids.size() * 2));
-                fflush(stdout);    
-            }
-            
-
-            // The initial set is same as the current grid
-            vector<Interval> initialState = grids[start];
-            for (int i = 0; i < ucnt; i++) {
-                initialState.push_back(Interval(0));
+            bool resumed = true;
+            for (auto &signs: symmetries) {
+                resumed = resumed && done[meet].test(mirrorGridId(start, signs));
             }
-            Flowpipe initial_set(initialState);
-            Result_of_Reachability result;
-
-            // Calculate the input if it meets the deadline.
-            if (meet) {
-                for (int i = 0; i < ucnt; i++) {
-                    TaylorModel<Real> tm_u;
-                    uexpr[i].evaluate(tm_u, initial_set.tmvPre.tms, order, initial_set.domain, setting.tm_setting.cutoff_threshold, setting.g_setting);
-                    initial_set.tmvPre.tms[xcnt + i] = tm_u;    
+            if (!resumed) {
+                buildSymmetricOneStepEdges(start, meet);
+                for (auto &signs: symmetries) {
+                    writeCheckpoint(mirrorGridId(start, signs), meet);
                 }
             }
+            progressDone++;
+        }
+    }
+    stopProgress();
+    if (checkpointFile && shardCnt == 1) {
+        // The graph is complete, a later run has nothing to resume.
+        fclose(checkpointFile);
+        checkpointFile = NULL;
+        unlink(checkpointPath().c_str());
+    }
+    closeCheckpoint();
+    for (int start = 0; start < grids.size(); start++) {
+        edgeCnt += oneStepGraph[start][0].size() + oneStepGraph[start][1].size();
+    }
+    printf("[Success] Number of edges: %d\n", edgeCnt);
+}
 
-            // Move forward one step
-            vector<Constraint> unsafeSet;
-            vector<Interval> reachableState;
-            dynamics.reach(result, setting, initial_set, unsafeSet);
-            result.fp_end_of_time.intEval(reachableState, order, setting.tm_setting.cutoff_threshold);
-            
-            // Check safety and build edge
-            bool safe = true;
-            for (int i = 0; i < xcnt; i++) {
-                double segLen = reachableState[i].width();
-                double inLen = reachableState[i].intersect(safeStateInterval[i]).width();
-                if (abs(segLen - inLen) > eps) {
-                    safe = false;
-                }
-            }
-            if (safe) {
-                getIntersectGridsId(0, 0, reachableState, oneStepGraph[start][meet]);
-                edgeCnt += oneStepGraph[start][meet].size();
+// Collects the edge lists of every shard of the model, whatever shard count they were built with.
+bool mergeShards() {
+    PhaseTimer timer(PHASE_ONE_STEP);
+    printf("[Info] Merging one-step graph shards.\n");
+    int n = grids.size();
+    oneStepGraph.assign(n, vector<vector<int>>(2));
+    dynamic_bitset<> done[2] = {dynamic_bitset<>(n), dynamic_bitset<>(n)};
+    sprintf(buf, "%016llx_%d_", modelHash(), d);
+    string prefix = buf;
+    DIR *dir = opendir(resultDir.c_str());
+    if (dir) {
+        while (dirent *entry = readdir(dir)) {
+            string name = entry->d_name;
+            if (name.compare(0, prefix.size(), prefix) || name.size() < 4 || name.compare(name.size() - 4, 4, ".log")) continue;
+            FILE *file = fopen((resultDir + name).c_str(), "rb");
+            if (!file) continue;
+            long valid = 0;
+            int cnt = readEdgeLog(file, done, valid);
+            fclose(file);
+            if (cnt >= 0) {
+                printf("       %s: %d edge lists\n", name.c_str(), cnt);
             }
         }
+        closedir(dir);
+    }
+    int missing = n * 2 - done[0].count() - done[1].count();
+    if (missing) {
+        printf("[Error] %d edge lists are missing, run the remaining shards first.\n", missing);
+        return false;
+    }
+    int edgeCnt = 0;
+    for (int id = 0; id < n; id++) {
+        edgeCnt += oneStepGraph[id][0].size() + oneStepGraph[id][1].size();
     }
-    printf("\r       Process: 100.00%%\n");
     printf("[Success] Number of edges: %d\n", edgeCnt);
+    return true;
 }
 
 void buildKStepGraph() {
+    PhaseTimer timer(PHASE_K_STEP);
     printf("[Info] Building K-step graph.\n");
     int n = grids.size();
     vector<vector<dynamic_bitset<>>> dp[2];  // grid, miss cnt
@@ -287,6 +1051,7 @@ void buildKStepGraph() {
 }
 
 void findLargestClosedSubgraph() {
+    PhaseTimer timer(PHASE_CLOSED);
     printf("[Info] Finding the largest closed subgraph.\n");
     int n = grids.size();
     dynamic_bitset<> visit(n);
@@ -312,7 +1077,8 @@ void findLargestClosedSubgraph() {
     printf("[Success] Safe Initial Region Size: %d\n", Ti.count());
 }
 
-void checkSafety() {
+bool checkSafety() {
+    PhaseTimer timer(PHASE_CHECK);
     printf("[Info] Calculating area.\n");
     double area = 1, gridArea = 0;
     for (int d = 0; d < xcnt; d++) {
@@ -337,95 +1103,1944 @@ void checkSafety() {
     printf("       Grids Intersection:   %f\n", gridArea);
     if (abs(area - gridArea) / area < 1e-6) {
         printf("       Result: safe\n");
+        jobResult = 1;
+        return true;
     } else {
         printf("       Result: unsafe\n");
+        jobResult = 2;
+        return false;
     }
 }
 
-void plotGrids() {
-    if (grids[0].size() == 1) {
-        printf("[Warning] No result image for 1 dimension.\n");
-        double l = 1e100, r = 1e-100;
-        for (int i = 0; i < grids.size(); i++) {
-            if (!Ti.test(i)) continue;
-            Interval dim = grids[i][0];
-            l = min(l, dim.inf());
-            r = max(r, dim.sup());
+vector<int> &getOneStepEdges(int id, int meet) {
+    if (!oneStepDone.test(id)) {
+        int start = getSymmetryRepresentative(id);
+        for (int i = 0; i < 2; i++) {
+            buildSymmetricOneStepEdges(start, i);
         }
-        if (l < r) {
-            printf("          Safe initial region: from %f to %f.\n", l, r);    
+        for (auto &signs: symmetries) {
+            oneStepDone.set(mirrorGridId(start, signs));
         }
-        return;
     }
-    Gnuplot gp;
-    gp << "set terminal svg size 480, 480\n";
-    gp << "set output 'output.svg'\n";
-    gp << "set xrange [ " << safeStateInterval[0].inf() << " : " << safeStateInterval[0].sup() << " ]\n";
-    gp << "set yrange [ " << safeStateInterval[1].inf() << " : " << safeStateInterval[1].sup() << " ]\n";
-    vector<int> rowId;
-    Interval colInt;
-    int prevColId = 0;
-    for (int i = 0; i < grids.size(); i++) {
-        if (!Ti.test(i)) continue;
-        if (rowId.size() && (i / d > prevColId ||  i != rowId.back() + 1)) {
-            sprintf(buf, "set object rect from %f,%f to %f,%f fc 'green' fillstyle solid 1.0 noborder\n",
-                colInt.inf(), grids[rowId.front()][1].inf(), colInt.sup(), grids[rowId.back()][1].sup());
-            gp << buf;
-            rowId.clear();
-        }
-        prevColId = i / d;
-        colInt = grids[i][0];
-        rowId.push_back(i);
-    }
-    if (rowId.size()) {
-        sprintf(buf, "set object rect from %f,%f to %f,%f fc 'green' fillstyle solid 1.0 noborder\n",
-            colInt.inf(), grids[rowId.front()][1].inf(), colInt.sup(), grids[rowId.back()][1].sup());
-        gp << buf;
-        rowId.clear();
-    }
-    prevColId = 0;
-    for (int i = 0; i < grids.size(); i++) {
-        if (!Ts.test(i)) continue;
-        if (rowId.size() && (i / d > prevColId ||  i != rowId.back() + 1)) {
-            sprintf(buf, "set object rect from %f,%f to %f,%f fc lt 2 fillstyle pattern 4 noborder\n",
-                colInt.inf(), grids[rowId.front()][1].inf(), colInt.sup(), grids[rowId.back()][1].sup());
-            gp << buf;
-            rowId.clear();
-        }
-        prevColId = i / d;
-        colInt = grids[i][0];
-        rowId.push_back(i);
-    }
-    if (rowId.size()) {
-        sprintf(buf, "set object rect from %f,%f to %f,%f fc lt 2 fillstyle pattern 4 noborder\n",
-            colInt.inf(), grids[rowId.front()][1].inf(), colInt.sup(), grids[rowId.back()][1].sup());
-        gp << buf;
-        rowId.clear();
+    return oneStepGraph[id][meet];
+}
+
+// Same transition as buildKStepGraph(), but only for the grids that are actually reached.
+const vector<int> &getKStepReach(int id, int steps, int miss) {
+    long long key = ((long long)id * (k + 1) + steps) * (m + 1) + miss;
+    auto it = kStepMemo.find(key);
+    if (it != kStepMemo.end()) {
+        return it->second;
     }
-    // initial state set
-    {
-        Interval dim0 = initialStateInterval[0];
-        Interval dim1 = initialStateInterval[1];
-        sprintf(buf, "set object rect from %f,%f to %f,%f lw 3 fs empty border fc 'blue'\n",
-            dim0.inf(), dim1.inf(), dim0.sup(), dim1.sup());
-        gp << buf;
+    vector<int> reach;
+    if (steps == 0) {
+        reach.push_back(id);  // can only reach itself in 0 step
+    } else {
+        bool safe = true;
+        set<int> reachSet;
+        for (int meet = 0; meet < 2 && safe; meet++) {
+            // try not meet when miss cnt < m
+            if (!meet && miss == m) continue;
+            vector<int> &edges = getOneStepEdges(id, meet);
+            if (edges.size() == 0) {
+                safe = false;
+            }
+            for (int reachId: edges) {
+                const vector<int> &nextReach = getKStepReach(reachId, steps - 1, meet ? miss : miss + 1);
+                if (nextReach.size() == 0) {
+                    safe = false;
+                    break;
+                }
+                reachSet.insert(nextReach.begin(), nextReach.end());
+            }
+        }
+        if (safe) {
+            reach.assign(reachSet.begin(), reachSet.end());
+        }
     }
-    gp << "set nokey\n";
-    // gp << "set key outside\n";
-    // gp << "set key right top\n";
-    gp << "plot NaN title 'Safe state region' with boxes fc 'black', ";
-    gp << "NaN title 'Safe initial state region' with boxes fc 'green' fillstyle solid 1.0 noborder, ";
-    gp << "NaN title 'Local safety region' with boxes fc lt 2 fillstyle pattern 4, ";
-    gp << "NaN title 'Initial state region' with boxes lw 3 fs empty border fc 'blue'\n";
+    return kStepMemo[key] = reach;
 }
 
-int main(int argc, char** argv) {
-    parseModel(argv[1]);
-    buildFlowstar();
-    buildGrids();
-    buildOneStepGraph();
-    buildKStepGraph();
-    findLargestClosedSubgraph();
-    checkSafety();
-    plotGrids();
+void checkVerdict() {
+    PhaseTimer timer(PHASE_CHECK);
+    printf("[Info] Exploring grids from the initial region.\n");
+    int n = countGrids();
+    oneStepGraph.resize(n);
+    oneStepDone.resize(n);
+
+    // The initial region must be covered by the grids
+    double area = 1, coveredArea = 1;
+    for (int d = 0; d < xcnt; d++) {
+        area *= initialStateInterval[d].width();
+        coveredArea *= max(initialStateInterval[d].intersect(safeStateInterval[d]).width(), 0.0);
+    }
+    bool safe = abs(area - coveredArea) / area < 1e-6;
+
+    // Every grid K-step reachable from an initial grid must be in Ts, otherwise
+    // the initial grid is not in the largest closed subgraph Ti.
+    vector<int> initialGrids;
+    if (safe) {
+        getIntersectGridsId(0, 0, initialStateInterval, initialGrids);
+    }
+    dynamic_bitset<> visit(n);
+    queue<int> que;
+    for (int id: initialGrids) {
+        visit.set(id);
+        que.push(id);
+    }
+    int explored = 0;
+    startProgress("Explored", 0);
+    while (safe && !que.empty()) {
+        int id = que.front();
+        que.pop();
+        explored += 1;
+        const vector<int> &reach = getKStepReach(id, k, 0);
+        progressDone++;
+        if (reach.size() == 0) {
+            safe = false;
+            break;
+        }
+        for (int nextId: reach) {
+            if (visit.test(nextId)) continue;
+            visit.set(nextId);
+            que.push(nextId);
+        }
+    }
+    stopProgress();
+    printf("[Success] Explored Region Size: %d\n", explored);
+    printf("          One-step Grids: %d / %d\n", (int)oneStepDone.count(), n);
+    if (safe) {
+        printf("       Result: safe\n");
+        jobResult = 1;
+    } else {
+        printf("       Result: unsafe\n");
+        jobResult = 2;
+    }
+}
+
+void getIntersectNodesId(int node, vector<Interval> &region, vector<int> &gridsId) {
+    if (gridTree[node].gridId >= 0) {
+        gridsId.push_back(gridTree[node].gridId);
+        return;
+    }
+    for (int c = gridTree[node].child; c < gridTree[node].child + (1 << xcnt); c++) {
+        bool intersect = true;
+        for (int i = 0; i < xcnt; i++) {
+            if (gridTree[c].box[i].intersect(region[i]).width() < eps) {
+                intersect = false;
+                break;
+            }
+        }
+        if (intersect) {
+            getIntersectNodesId(c, region, gridsId);
+        }
+    }
+}
+
+void getIntersectAdaptiveGridsId(vector<Interval> &region, vector<int> &gridsId) {
+    vector<int> rootsId;
+    getIntersectGridsId(0, 0, region, rootsId);
+    for (int root: rootsId) {
+        getIntersectNodesId(root, region, gridsId);
+    }
+}
+
+void buildAdaptiveOneStepGraph(vector<int> &dirtyGrids) {
+    PhaseTimer timer(PHASE_ONE_STEP);
+    printf("[Info] Building one-step graph.\n");
+    int n = grids.size();
+    oneStepGraph.resize(n);
+    reachBoxes.resize(n);
+    reachDone.resize(n);
+    startProgress("Process", dirtyGrids.size());
+    for (int id: dirtyGrids) {
+        // Only new grids need the flowpipes, the others only need the edges again.
+        bool hasPrevious = reachBoxes[id].size() == 2;
+        oneStepGraph[id].resize(2);
+        reachBoxes[id].resize(2);
+        for (int meet = 0; meet < 2; meet++) {
+            if (!reachDone.test(id)) {
+                vector<Interval> reachableState;
+                if (buildReachableState(grids[id], meet, reachableState)) {
+                    // The previous box of a larger grid containing this one is also an over-approximation.
+                    if (hasPrevious && reachBoxes[id][meet].size()) {
+                        for (int i = 0; i < xcnt; i++) {
+                            reachableState[i] = reachableState[i].intersect(reachBoxes[id][meet][i]);
+                        }
+                    }
+                    reachBoxes[id][meet] = reachableState;
+                }
+            }
+            oneStepGraph[id][meet].clear();
+            if (reachBoxes[id][meet].size()) {
+                getIntersectAdaptiveGridsId(reachBoxes[id][meet], oneStepGraph[id][meet]);
+            }
+        }
+        reachDone.set(id);
+        progressDone++;
+    }
+    stopProgress();
+    int edgeCnt = 0;
+    for (int id = 0; id < n; id++) {
+        edgeCnt += oneStepGraph[id][0].size() + oneStepGraph[id][1].size();
+    }
+    printf("[Success] Number of edges: %d\n", edgeCnt);
+}
+
+// Grids which are not in Ti and K-step reachable from the initial region cause the unsafe result.
+void findCounterexampleGrids(vector<int> &counterexampleGrids) {
+    int n = grids.size();
+    vector<vector<int>> kStepGraph(n);
+    for (int id = 0; id < n; id++) {
+        for (int prevId: revKStepGraph[id]) {
+            kStepGraph[prevId].push_back(id);
+        }
+    }
+    vector<int> initialGrids;
+    getIntersectAdaptiveGridsId(initialStateInterval, initialGrids);
+    dynamic_bitset<> visit(n);
+    queue<int> que;
+    for (int id: initialGrids) {
+        if (Ti.test(id)) continue;
+        visit.set(id);
+        que.push(id);
+    }
+    while (!que.empty()) {
+        int id = que.front();
+        que.pop();
+        counterexampleGrids.push_back(id);
+        for (int nextId: kStepGraph[id]) {
+            if (visit.test(nextId) || Ti.test(nextId)) continue;
+            visit.set(nextId);
+            que.push(nextId);
+        }
+    }
+    // A grid not in Ts fails within k steps, so do the grids it reaches in less than k steps.
+    vector<int> frontier;
+    for (int id: counterexampleGrids) {
+        if (!Ts.test(id)) {
+            frontier.push_back(id);
+        }
+    }
+    for (int step = 1; step < k; step++) {
+        vector<int> nextFrontier;
+        for (int id: frontier) {
+            for (int meet = 0; meet < 2; meet++) {
+                for (int nextId: oneStepGraph[id][meet]) {
+                    if (visit.test(nextId) || Ti.test(nextId)) continue;
+                    visit.set(nextId);
+                    counterexampleGrids.push_back(nextId);
+                    nextFrontier.push_back(nextId);
+                }
+            }
+        }
+        frontier.swap(nextFrontier);
+    }
+}
+
+void splitGrids(vector<int> &splitGrids, vector<int> &dirtyGrids) {
+    printf("[Info] Splitting %d grids.\n", (int)splitGrids.size());
+    dynamic_bitset<> split(grids.size());
+    for (int id: splitGrids) {
+        split.set(id);
+    }
+    // The grids reaching a split grid need new edges.
+    dynamic_bitset<> dirty(grids.size());
+    for (int id = 0; id < grids.size(); id++) {
+        for (int meet = 0; meet < 2; meet++) {
+            for (int reachId: oneStepGraph[id][meet]) {
+                if (split.test(reachId)) {
+                    dirty.set(id);
+                }
+            }
+        }
+    }
+    for (int id = 0; id < grids.size(); id++) {
+        if (dirty.test(id) && !split.test(id)) {
+            dirtyGrids.push_back(id);
+        }
+    }
+    // Bisect every dimension, the first child keeps the id of its parent.
+    for (int id: splitGrids) {
+        int node = gridNode[id];
+        int child = gridTree.size();
+        vector<Interval> parentBox = gridTree[node].box;
+        int depth = gridTree[node].depth + 1;
+        gridTree[node].gridId = -1;
+        gridTree[node].child = child;
+        for (int mask = 0; mask < (1 << xcnt); mask++) {
+            vector<Interval> box(xcnt);
+            for (int i = 0; i < xcnt; i++) {
+                double mid = (parentBox[i].inf() + parentBox[i].sup()) / 2;
+                if (mask >> i & 1) {
+                    box[i] = Interval(mid, parentBox[i].sup());
+                } else {
+                    box[i] = Interval(parentBox[i].inf(), mid);
+                }
+            }
+            int childId = id;
+            if (mask == 0) {
+                grids[id] = box;
+                reachDone.reset(id);
+            } else {
+                childId = grids.size();
+                grids.push_back(box);
+                gridNode.push_back(0);
+                reachBoxes.push_back(reachBoxes[id]);
+            }
+            gridNode[childId] = child + mask;
+            gridTree.push_back({box, childId, -1, depth});
+            dirtyGrids.push_back(childId);
+        }
+    }
+}
+
+string graphPath() {
+    sprintf(buf, "%s%016llx_%d_%d_%d.graph", resultDir.c_str(), modelHash(), d, m, k);
+    return buf;
+}
+
+// A new file next to path, renamed over it once complete. The name is unique, so jobs
+// writing the same result at once do not write into one file.
+FILE *openTemp(const string &path, string &tmpPath) {
+    tmpPath = path + ".XXXXXX";
+    int fd = mkstemp(&tmpPath[0]);
+    if (fd < 0) {
+        return NULL;
+    }
+    fchmod(fd, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    FILE *file = fdopen(fd, "wb");
+    if (!file) {
+        close(fd);
+        unlink(tmpPath.c_str());
+    }
+    return file;
+}
+
+void writeSection(FILE *file, uint64_t &offset, const void *data, size_t size) {
+    const char padding[8] = {};
+    offset = ftell(file);
+    fwrite(data, 1, size, file);
+    fwrite(padding, 1, (8 - size % 8) % 8, file);
+}
+
+void writeGraphSection(FILE *file, uint64_t &indexOffset, uint64_t &edgesOffset, vector<vector<int>> &graph) {
+    vector<uint64_t> index(1, 0);
+    vector<uint32_t> edges;
+    for (auto &nextIds: graph) {
+        edges.insert(edges.end(), nextIds.begin(), nextIds.end());
+        index.push_back(edges.size());
+    }
+    writeSection(file, indexOffset, index.data(), index.size() * sizeof(uint64_t));
+    writeSection(file, edgesOffset, edges.data(), edges.size() * sizeof(uint32_t));
+}
+
+void writeBitsetSection(FILE *file, uint64_t &offset, dynamic_bitset<> &bits) {
+    vector<uint64_t> words((bits.size() + 63) / 64);
+    for (int id = 0; id < bits.size(); id++) {
+        if (bits.test(id)) {
+            words[id / 64] |= 1ULL << (id % 64);
+        }
+    }
+    writeSection(file, offset, words.data(), words.size() * sizeof(uint64_t));
+}
+
+// See result.h for the layout.
+void writeGraphFile() {
+    mkdir(resultDir.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    string path = graphPath();
+    string tmpPath;
+    FILE *file = openTemp(path, tmpPath);
+    if (!file) {
+        printf("[Warning] Can not write the graphs to %s.\n", path.c_str());
+        return;
+    }
+    int n = grids.size();
+    ResultHeader header = {};
+    memcpy(header.magic, RESULT_MAGIC, sizeof(header.magic));
+    header.version = RESULT_VERSION;
+    header.xcnt = xcnt;
+    header.d = d;
+    header.m = m;
+    header.k = k;
+    header.gridCnt = n;
+    header.modelHash = modelHash();
+    fwrite(&header, sizeof(header), 1, file);
+
+    vector<double> bounds;
+    for (Interval &dim: safeStateInterval) {
+        bounds.push_back(dim.inf());
+        bounds.push_back(dim.sup());
+    }
+    writeSection(file, header.safeState, bounds.data(), bounds.size() * sizeof(double));
+    for (int meet = 0; meet < 2; meet++) {
+        vector<vector<int>> graph(n);
+        for (int id = 0; id < n; id++) {
+            graph[id] = oneStepGraph[id][meet];
+        }
+        writeGraphSection(file, header.oneStepIndex[meet], header.oneStepEdges[meet], graph);
+    }
+    vector<vector<int>> kStepGraph(n);
+    for (int id = 0; id < n; id++) {
+        for (int prevId: revKStepGraph[id]) {
+            kStepGraph[prevId].push_back(id);
+        }
+    }
+    writeGraphSection(file, header.kStepIndex, header.kStepEdges, kStepGraph);
+    writeBitsetSection(file, header.Ts, Ts);
+    writeBitsetSection(file, header.Tk, Tk);
+    writeBitsetSection(file, header.Ti, Ti);
+    header.size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, file);
+    fclose(file);
+    rename(tmpPath.c_str(), path.c_str());
+    printf("[Info] Graphs saved to %s.\n", path.c_str());
+}
+
+// whether a section of size bytes at offset is aligned and lies within the file
+bool validSection(uint64_t offset, uint64_t size, uint64_t fileSize) {
+    return offset % 8 == 0 && offset >= sizeof(ResultHeader) && offset <= fileSize && size <= fileSize - offset;
+}
+
+// Checks that the index of a graph section is monotonic and that its edges lie within the file and
+// are grid ids. Returns the number of edges, -1 if the section is invalid.
+long checkGraphSection(const char *data, uint64_t fileSize, uint64_t indexOffset, uint64_t edgesOffset, int n) {
+    if (!validSection(indexOffset, (n + 1ULL) * sizeof(uint64_t), fileSize)) {
+        return -1;
+    }
+    const uint64_t *index = (const uint64_t *)(data + indexOffset);
+    if (index[0] != 0) {
+        return -1;
+    }
+    for (int id = 0; id < n; id++) {
+        if (index[id + 1] < index[id]) {
+            return -1;
+        }
+    }
+    if (index[n] > fileSize / sizeof(uint32_t) || !validSection(edgesOffset, index[n] * sizeof(uint32_t), fileSize)) {
+        return -1;
+    }
+    const uint32_t *edges = (const uint32_t *)(data + edgesOffset);
+    for (uint64_t i = 0; i < index[n]; i++) {
+        if (edges[i] >= n) {
+            return -1;
+        }
+    }
+    return index[n];
+}
+
+void readBitsetSection(const char *data, uint64_t offset, dynamic_bitset<> &bits) {
+    const uint64_t *words = (const uint64_t *)(data + offset);
+    bits.resize(grids.size());
+    for (int id = 0; id < grids.size(); id++) {
+        bits[id] = words[id / 64] >> (id % 64) & 1;
+    }
+}
+
+bool loadGraphFile() {
+    printf("[Info] Loading graphs.\n");
+    string path = graphPath();
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        printf("[Error] Can not open %s, run the same model with the same m and k first.\n", path.c_str());
+        return false;
+    }
+    struct stat st;
+    fstat(fd, &st);
+    void *map = st.st_size >= sizeof(ResultHeader) ? mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (map == MAP_FAILED) {
+        printf("[Error] Invalid result file %s.\n", path.c_str());
+        return false;
+    }
+    const char *data = (const char *)map;
+    const ResultHeader *header = (const ResultHeader *)data;
+    int n = grids.size();
+    if (memcmp(header->magic, RESULT_MAGIC, sizeof(header->magic)) || header->version != RESULT_VERSION ||
+        header->xcnt != xcnt || header->d != d || header->m != m || header->k != k || header->gridCnt != n ||
+        header->modelHash != modelHash() || header->size != st.st_size) {
+        printf("[Error] Invalid result file %s.\n", path.c_str());
+        munmap(map, st.st_size);
+        return false;
+    }
+    // Only the regions are needed to check and plot the result, the graphs are checked and counted in place.
+    uint64_t bitsetSize = (n + 63) / 64 * sizeof(uint64_t);
+    long oneStepEdges[2];
+    for (int meet = 0; meet < 2; meet++) {
+        oneStepEdges[meet] = checkGraphSection(data, st.st_size, header->oneStepIndex[meet], header->oneStepEdges[meet], n);
+    }
+    loadedEdges[1] = checkGraphSection(data, st.st_size, header->kStepIndex, header->kStepEdges, n);
+    if (!validSection(header->safeState, 2 * xcnt * sizeof(double), st.st_size) || oneStepEdges[0] < 0 ||
+        oneStepEdges[1] < 0 || loadedEdges[1] < 0 || !validSection(header->Ts, bitsetSize, st.st_size) ||
+        !validSection(header->Tk, bitsetSize, st.st_size) || !validSection(header->Ti, bitsetSize, st.st_size)) {
+        printf("[Error] Invalid result file %s.\n", path.c_str());
+        munmap(map, st.st_size);
+        return false;
+    }
+    loadedEdges[0] = oneStepEdges[0] + oneStepEdges[1];
+    oneStepGraph.clear();
+    revKStepGraph.clear();
+    readBitsetSection(data, header->Ts, Ts);
+    readBitsetSection(data, header->Tk, Tk);
+    readBitsetSection(data, header->Ti, Ti);
+    munmap(map, st.st_size);
+    printf("[Success] Start Region Size: %d\n", Ts.count());
+    printf("          End Region: %d\n", Tk.count());
+    printf("          Safe Initial Region Size: %d\n", Ti.count());
+    return true;
+}
+
+// Plot
+struct PlotRect {
+    double x0, y0, x1, y1;
+};
+const int plotSize = 480;
+const double plotLeft = 60, plotRight = 465, plotTop = 18, plotBottom = 444;
+
+// plotted dimensions and the dimensions fixed by --slice, the others are projected
+string plotAxisNames[2];
+vector<pair<string, double>> plotSliceNames;
+int plotAxes[2] = {0, 1};
+vector<pair<int, double>> plotSlices;
+
+bool resolvePlotAxes() {
+    for (int axis = 0; axis < 2; axis++) {
+        if (plotAxisNames[axis].empty()) continue;
+        plotAxes[axis] = stateVars.getIDForVar(plotAxisNames[axis]);
+        if (plotAxes[axis] < 0 || plotAxes[axis] >= xcnt) {
+            printf("[Warning] Unknown plot axis %s.\n", plotAxisNames[axis].c_str());
+            return false;
+        }
+    }
+    if (plotAxes[0] == plotAxes[1]) {
+        printf("[Warning] The plot axes must be different.\n");
+        return false;
+    }
+    plotSlices.clear();
+    for (auto &slice: plotSliceNames) {
+        int dim = stateVars.getIDForVar(slice.first);
+        if (dim < 0 || dim >= xcnt || dim == plotAxes[0] || dim == plotAxes[1]) {
+            printf("[Warning] Can not slice at %s.\n", slice.first.c_str());
+            return false;
+        }
+        plotSlices.push_back({dim, slice.second});
+    }
+    return true;
+}
+
+bool inPlotSlice(vector<Interval> &grid) {
+    for (auto &slice: plotSlices) {
+        if (slice.second < grid[slice.first].inf() - eps || slice.second > grid[slice.first].sup() + eps) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// The plot lattice splits both axes into d << plotDepth() cells, the finest cells --adaptive can split the grids into.
+int plotDepth() {
+    return adaptiveMode ? maxDepth : 0;
+}
+
+// the lattice cells [x0, x1) x [y0, y1) of a grid, computed from its id or its node, false if the plot slice misses it
+bool getPlotCells(int id, int depth, int &x0, int &x1, int &y0, int &y1) {
+    int index[2], gridDepth = 0;
+    if (!gridTree.empty()) {
+        GridNode &node = gridTree[gridNode[id]];
+        for (auto &slice: plotSlices) {
+            Interval &dim = node.box[slice.first];
+            if (slice.second < dim.inf() - eps || slice.second > dim.sup() + eps) {
+                return false;
+            }
+        }
+        gridDepth = node.depth;
+        for (int axis = 0; axis < 2; axis++) {
+            Interval &dim = safeStateInterval[plotAxes[axis]];
+            double blockSize = (dim.sup() - dim.inf()) / (d << gridDepth);
+            index[axis] = lround((node.box[plotAxes[axis]].inf() - dim.inf()) / blockSize);
+        }
+    } else {
+        // the first dimension is the most significant digit of the id, as in getGrid
+        for (int curDim = xcnt - 1; curDim >= 0; curDim--) {
+            int i = id % d;
+            id /= d;
+            for (auto &slice: plotSlices) {
+                if (slice.first != curDim) continue;
+                double blockSize = (safeStateInterval[curDim].sup() - safeStateInterval[curDim].inf()) / d;
+                double start = safeStateInterval[curDim].inf() + i * blockSize;
+                double end = safeStateInterval[curDim].inf() + (i + 1) * blockSize;
+                if (slice.second < start - eps || slice.second > end + eps) {
+                    return false;
+                }
+            }
+            for (int axis = 0; axis < 2; axis++) {
+                if (plotAxes[axis] == curDim) {
+                    index[axis] = i;
+                }
+            }
+        }
+    }
+    int span = 1 << (depth - gridDepth);
+    x0 = index[0] * span;
+    x1 = x0 + span;
+    y0 = index[1] * span;
+    y1 = y0 + span;
+    return true;
+}
+
+// sorts the runs [x0, x1) of a plot row and joins the overlapping and adjacent ones
+void joinPlotRuns(vector<pair<int, int>> &row) {
+    sort(row.begin(), row.end());
+    int cnt = 0;
+    for (auto &run: row) {
+        if (cnt > 0 && run.first <= row[cnt - 1].second) {
+            row[cnt - 1].second = max(row[cnt - 1].second, run.second);
+        } else {
+            row[cnt++] = run;
+        }
+    }
+    row.resize(cnt);
+}
+
+// removes [x0, x1) from the run of the row containing it, false if no run contains it
+bool cutPlotRun(vector<pair<int, int>> &row, int x0, int x1) {
+    auto run = upper_bound(row.begin(), row.end(), x0, [](int x, const pair<int, int> &r) { return x < r.first; });
+    if (run == row.begin()) return false;
+    --run;
+    if (run->second < x1) return false;
+    pair<int, int> right = {x1, run->second};
+    if (run->first < x0) {
+        run->second = x0;
+        if (right.first < right.second) {
+            row.insert(run + 1, right);
+        }
+    } else if (right.first < right.second) {
+        *run = right;
+    } else {
+        row.erase(run);
+    }
+    return true;
+}
+
+// Projects the grids of the region in the slice onto the plot axes, as runs of plot cells per row, and covers
+// the runs greedily: a rectangle spans a run of its first row and goes down as long as the next row contains it.
+// This is no minimal cover, but the cost grows with the runs and the rectangles instead of the plot cells.
+void mergePlotRects(dynamic_bitset<> &region, vector<PlotRect> &rects) {
+    int depth = plotDepth();
+    vector<vector<pair<int, int>>> rows(d << depth);  // [y] runs [x0, x1) in the region
+    for (size_t id = region.find_first(); id != dynamic_bitset<>::npos; id = region.find_next(id)) {
+        int x0, x1, y0, y1;
+        if (!getPlotCells(id, depth, x0, x1, y0, y1)) continue;
+        for (int y = y0; y < y1; y++) {
+            rows[y].push_back({x0, x1});
+        }
+    }
+    for (auto &row: rows) {
+        joinPlotRuns(row);
+    }
+    Interval &dimX = safeStateInterval[plotAxes[0]], &dimY = safeStateInterval[plotAxes[1]];
+    double cellX = (dimX.sup() - dimX.inf()) / rows.size(), cellY = (dimY.sup() - dimY.inf()) / rows.size();
+    for (int y = 0; y < rows.size(); y++) {
+        for (auto &run: rows[y]) {
+            int y1 = y + 1;
+            while (y1 < rows.size() && cutPlotRun(rows[y1], run.first, run.second)) {
+                y1++;
+            }
+            rects.push_back({dimX.inf() + run.first * cellX, dimY.inf() + y * cellY,
+                dimX.inf() + run.second * cellX, dimY.inf() + y1 * cellY});
+        }
+    }
+}
+
+double plotX(double x) {
+    Interval &dim = safeStateInterval[plotAxes[0]];
+    return plotLeft + (x - dim.inf()) / (dim.sup() - dim.inf()) * (plotRight - plotLeft);
+}
+
+double plotY(double y) {
+    Interval &dim = safeStateInterval[plotAxes[1]];
+    return plotBottom - (y - dim.inf()) / (dim.sup() - dim.inf()) * (plotBottom - plotTop);
+}
+
+void getPlotTicks(Interval &range, vector<double> &ticks) {
+    double raw = (range.sup() - range.inf()) / 6;
+    double mag = pow(10, floor(log10(raw)));
+    double norm = raw / mag;
+    double step = (norm < 1.5 ? 1 : norm < 3 ? 2 : norm < 7 ? 5 : 10) * mag;
+    for (double tick = ceil(range.inf() / step - 1e-9) * step; tick <= range.sup() + step * 1e-9; tick += step) {
+        ticks.push_back(abs(tick) < step * 1e-9 ? 0 : tick);
+    }
+}
+
+void writeSvg(FILE *file, vector<PlotRect> &safeRects, vector<PlotRect> &localRects) {
+    fprintf(file, "<?xml version=\"1.0\" encoding=\"utf-8\" standalone=\"no\"?>\n");
+    fprintf(file, "<svg width=\"%d\" height=\"%d\" viewBox=\"0 0 %d %d\" xmlns=\"http://www.w3.org/2000/svg\">\n",
+        plotSize, plotSize, plotSize, plotSize);
+    fprintf(file, "<defs><pattern id=\"hatch\" width=\"8\" height=\"8\" patternUnits=\"userSpaceOnUse\">"
+        "<path d=\"M-2,2 L2,-2 M0,8 L8,0 M6,10 L10,6\" stroke=\"rgb(0,158,115)\" stroke-width=\"1\"/></pattern></defs>\n");
+    fprintf(file, "<rect x=\"0\" y=\"0\" width=\"%d\" height=\"%d\" fill=\"white\"/>\n", plotSize, plotSize);
+    fprintf(file, "<g fill=\"rgb(0,255,0)\" stroke=\"none\">\n");
+    for (PlotRect &rect: safeRects) {
+        fprintf(file, "<rect x=\"%.1f\" y=\"%.1f\" width=\"%.1f\" height=\"%.1f\"/>\n",
+            plotX(rect.x0), plotY(rect.y1), plotX(rect.x1) - plotX(rect.x0), plotY(rect.y0) - plotY(rect.y1));
+    }
+    fprintf(file, "</g>\n<g fill=\"url(#hatch)\" stroke=\"none\">\n");
+    for (PlotRect &rect: localRects) {
+        fprintf(file, "<rect x=\"%.1f\" y=\"%.1f\" width=\"%.1f\" height=\"%.1f\"/>\n",
+            plotX(rect.x0), plotY(rect.y1), plotX(rect.x1) - plotX(rect.x0), plotY(rect.y0) - plotY(rect.y1));
+    }
+    fprintf(file, "</g>\n");
+    // initial state set
+    if (inPlotSlice(initialStateInterval)) {
+        Interval &dim0 = initialStateInterval[plotAxes[0]], &dim1 = initialStateInterval[plotAxes[1]];
+        fprintf(file, "<rect x=\"%.1f\" y=\"%.1f\" width=\"%.1f\" height=\"%.1f\" fill=\"none\" stroke=\"rgb(0,0,255)\" stroke-width=\"3\"/>\n",
+            plotX(dim0.inf()), plotY(dim1.sup()), plotX(dim0.sup()) - plotX(dim0.inf()), plotY(dim1.inf()) - plotY(dim1.sup()));
+    }
+    // border and ticks
+    fprintf(file, "<g stroke=\"black\" fill=\"none\">\n");
+    fprintf(file, "<rect x=\"%.1f\" y=\"%.1f\" width=\"%.1f\" height=\"%.1f\"/>\n",
+        plotLeft, plotTop, plotRight - plotLeft, plotBottom - plotTop);
+    vector<double> xTicks, yTicks;
+    getPlotTicks(safeStateInterval[plotAxes[0]], xTicks);
+    getPlotTicks(safeStateInterval[plotAxes[1]], yTicks);
+    for (double tick: xTicks) {
+        fprintf(file, "<path d=\"M%.1f,%.1f v-9 M%.1f,%.1f v9\"/>\n", plotX(tick), plotBottom, plotX(tick), plotTop);
+    }
+    for (double tick: yTicks) {
+        fprintf(file, "<path d=\"M%.1f,%.1f h9 M%.1f,%.1f h-9\"/>\n", plotLeft, plotY(tick), plotRight, plotY(tick));
+    }
+    fprintf(file, "</g>\n<g font-family=\"Arial\" font-size=\"12\" fill=\"black\">\n");
+    for (double tick: xTicks) {
+        fprintf(file, "<text x=\"%.1f\" y=\"%.1f\" text-anchor=\"middle\">%g</text>\n", plotX(tick), plotBottom + 22, tick);
+    }
+    for (double tick: yTicks) {
+        fprintf(file, "<text x=\"%.1f\" y=\"%.1f\" text-anchor=\"end\">%g</text>\n", plotLeft - 8, plotY(tick) + 4, tick);
+    }
+    fprintf(file, "</g>\n</svg>\n");
+}
+
+// 5x7 glyphs of the tick labels, one row per byte
+const char *plotGlyphChars = "0123456789.-+e";
+const unsigned char plotGlyphs[][7] = {
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E},
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E},
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E},
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08},
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C},
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00},
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, {0x00, 0x00, 0x0E, 0x11, 0x1F, 0x10, 0x0E},
+};
+
+struct Raster {
+    vector<unsigned char> pixels;  // RGB rows
+
+    Raster(): pixels(plotSize * plotSize * 3, 255) {}
+
+    void set(int x, int y, unsigned int color) {
+        if (x < 0 || y < 0 || x >= plotSize || y >= plotSize) return;
+        unsigned char *pixel = &pixels[(y * plotSize + x) * 3];
+        pixel[0] = color >> 16;
+        pixel[1] = color >> 8;
+        pixel[2] = color;
+    }
+
+    // pixels with centers inside [x0, x1) x [y0, y1), hatch: only the diagonal stripes
+    void fillRect(double x0, double y0, double x1, double y1, unsigned int color, bool hatch=false) {
+        for (int y = max(0, (int)ceil(y0 - 0.5)); y < min(plotSize, (int)ceil(y1 - 0.5)); y++) {
+            for (int x = max(0, (int)ceil(x0 - 0.5)); x < min(plotSize, (int)ceil(x1 - 0.5)); x++) {
+                if (!hatch || (x + y) % 8 == 0) {
+                    set(x, y, color);
+                }
+            }
+        }
+    }
+
+    void strokeRect(double x0, double y0, double x1, double y1, int width, unsigned int color) {
+        double half = width / 2.0;
+        fillRect(x0 - half, y0 - half, x1 + half, y0 + half, color);
+        fillRect(x0 - half, y1 - half, x1 + half, y1 + half, color);
+        fillRect(x0 - half, y0 - half, x0 + half, y1 + half, color);
+        fillRect(x1 - half, y0 - half, x1 + half, y1 + half, color);
+    }
+
+    // scale 2, anchor: 0: left, 1: middle, 2: right of the text at x
+    void text(double x, double y, const char *str, int anchor) {
+        int len = strlen(str);
+        int left = (int)x - anchor * len * 6;
+        for (int i = 0; i < len; i++) {
+            const char *glyph = strchr(plotGlyphChars, str[i]);
+            if (!glyph) continue;
+            for (int row = 0; row < 7; row++) {
+                for (int col = 0; col < 5; col++) {
+                    if (plotGlyphs[glyph - plotGlyphChars][row] >> (4 - col) & 1) {
+                        fillRect(left + i * 12 + col * 2, y - 14 + row * 2, left + i * 12 + col * 2 + 2, y - 12 + row * 2, 0);
+                    }
+                }
+            }
+        }
+    }
+};
+
+unsigned int crc32(const unsigned char *data, size_t size, unsigned int crc=0) {
+    static unsigned int table[256];
+    if (!table[1]) {
+        for (unsigned int i = 0; i < 256; i++) {
+            unsigned int c = i;
+            for (int j = 0; j < 8; j++) {
+                c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+            }
+            table[i] = c;
+        }
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void writePngChunk(FILE *file, const char *type, vector<unsigned char> &data) {
+    unsigned char header[8] = {
+        (unsigned char)(data.size() >> 24), (unsigned char)(data.size() >> 16), (unsigned char)(data.size() >> 8), (unsigned char)data.size(),
+        (unsigned char)type[0], (unsigned char)type[1], (unsigned char)type[2], (unsigned char)type[3]};
+    unsigned int crc = crc32(header + 4, 4);
+    crc = crc32(data.data(), data.size(), crc);
+    unsigned char footer[4] = {(unsigned char)(crc >> 24), (unsigned char)(crc >> 16), (unsigned char)(crc >> 8), (unsigned char)crc};
+    fwrite(header, 1, 8, file);
+    fwrite(data.data(), 1, data.size(), file);
+    fwrite(footer, 1, 4, file);
+}
+
+// RGB image in a zlib stream of stored deflate blocks, so no compression library is needed.
+void writePng(FILE *file, Raster &raster) {
+    const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    fwrite(signature, 1, 8, file);
+    vector<unsigned char> ihdr = {0, 0, plotSize >> 8, plotSize & 0xFF, 0, 0, plotSize >> 8, plotSize & 0xFF, 8, 2, 0, 0, 0};
+    writePngChunk(file, "IHDR", ihdr);
+    vector<unsigned char> raw;
+    for (int y = 0; y < plotSize; y++) {
+        raw.push_back(0);  // no filter
+        raw.insert(raw.end(), raster.pixels.begin() + y * plotSize * 3, raster.pixels.begin() + (y + 1) * plotSize * 3);
+    }
+    vector<unsigned char> idat = {0x78, 0x01};
+    unsigned int a = 1, b = 0;  // Adler-32
+    for (size_t offset = 0; offset < raw.size(); offset += 65535) {
+        unsigned int len = min(raw.size() - offset, (size_t)65535);
+        idat.push_back(offset + len == raw.size());
+        idat.push_back(len & 0xFF);
+        idat.push_back(len >> 8);
+        idat.push_back(~len & 0xFF);
+        idat.push_back((~len >> 8) & 0xFF);
+        idat.insert(idat.end(), raw.begin() + offset, raw.begin() + offset + len);
+    }
+    for (unsigned char c: raw) {
+        a = (a + c) % 65521;
+        b = (b + a) % 65521;
+    }
+    unsigned int adler = b << 16 | a;
+    idat.push_back(adler >> 24);
+    idat.push_back(adler >> 16);
+    idat.push_back(adler >> 8);
+    idat.push_back(adler);
+    writePngChunk(file, "IDAT", idat);
+    vector<unsigned char> iend;
+    writePngChunk(file, "IEND", iend);
+}
+
+void writeRaster(FILE *file, vector<PlotRect> &safeRects, vector<PlotRect> &localRects) {
+    Raster raster;
+    for (PlotRect &rect: safeRects) {
+        raster.fillRect(plotX(rect.x0), plotY(rect.y1), plotX(rect.x1), plotY(rect.y0), 0x00FF00);
+    }
+    for (PlotRect &rect: localRects) {
+        raster.fillRect(plotX(rect.x0), plotY(rect.y1), plotX(rect.x1), plotY(rect.y0), 0x009E73, true);
+    }
+    if (inPlotSlice(initialStateInterval)) {
+        Interval &dim0 = initialStateInterval[plotAxes[0]], &dim1 = initialStateInterval[plotAxes[1]];
+        raster.strokeRect(plotX(dim0.inf()), plotY(dim1.sup()), plotX(dim0.sup()), plotY(dim1.inf()), 3, 0x0000FF);
+    }
+    raster.strokeRect(plotLeft, plotTop, plotRight, plotBottom, 1, 0);
+    vector<double> xTicks, yTicks;
+    getPlotTicks(safeStateInterval[plotAxes[0]], xTicks);
+    getPlotTicks(safeStateInterval[plotAxes[1]], yTicks);
+    for (double tick: xTicks) {
+        raster.fillRect(plotX(tick) - 0.5, plotBottom - 9, plotX(tick) + 0.5, plotBottom, 0);
+        raster.fillRect(plotX(tick) - 0.5, plotTop, plotX(tick) + 0.5, plotTop + 9, 0);
+        sprintf(buf, "%g", tick);
+        raster.text(plotX(tick), plotBottom + 22, buf, 1);
+    }
+    for (double tick: yTicks) {
+        raster.fillRect(plotLeft, plotY(tick) - 0.5, plotLeft + 9, plotY(tick) + 0.5, 0);
+        raster.fillRect(plotRight - 9, plotY(tick) - 0.5, plotRight, plotY(tick) + 0.5, 0);
+        sprintf(buf, "%g", tick);
+        raster.text(plotLeft - 8, plotY(tick) + 7, buf, 2);
+    }
+    writePng(file, raster);
+}
+
+void plotGrids() {
+    PhaseTimer timer(PHASE_PLOT);
+    if (grids[0].size() == 1) {
+        printf("[Warning] No result image for 1 dimension.\n");
+        double l = 1e100, r = 1e-100;
+        for (int i = 0; i < grids.size(); i++) {
+            if (!Ti.test(i)) continue;
+            Interval dim = grids[i][0];
+            l = min(l, dim.inf());
+            r = max(r, dim.sup());
+        }
+        if (l < r) {
+            printf("          Safe initial region: from %f to %f.\n", l, r);    
+        }
+        return;
+    }
+    if (!resolvePlotAxes()) return;
+    vector<PlotRect> safeRects, localRects;
+    mergePlotRects(Ti, safeRects);
+    mergePlotRects(Ts, localRects);
+    FILE *file = fopen(outputPath.c_str(), "wb");
+    if (!file) {
+        printf("[Warning] Can not write the result image to %s.\n", outputPath.c_str());
+        return;
+    }
+    bool png = outputPath.size() >= 4 && outputPath.compare(outputPath.size() - 4, 4, ".png") == 0;
+    if (png) {
+        writeRaster(file, safeRects, localRects);
+    } else {
+        writeSvg(file, safeRects, localRects);
+    }
+    fclose(file);
+}
+
+void runAdaptive() {
+    buildGrids();
+    for (int id = 0; id < grids.size(); id++) {
+        gridTree.push_back({grids[id], id, -1, 0});
+        gridNode.push_back(id);
+    }
+    double begin = getTime(CLOCK_MONOTONIC);
+    vector<int> dirtyGrids;
+    for (int id = 0; id < grids.size(); id++) {
+        dirtyGrids.push_back(id);
+    }
+    for (int round = 0; ; round++) {
+        printf("[Info] Refinement round %d: %d grids.\n", round, (int)grids.size());
+        buildAdaptiveOneStepGraph(dirtyGrids);
+        revKStepGraph.clear();
+        Ts.clear();
+        Tk.clear();
+        Ti.clear();
+        buildKStepGraph();
+        findLargestClosedSubgraph();
+        if (checkSafety()) {
+            break;
+        }
+        if (timeLimit > 0 && getTime(CLOCK_MONOTONIC) - begin > timeLimit) {
+            printf("[Warning] Time limit reached.\n");
+            break;
+        }
+        vector<int> counterexampleGrids, refinementGrids;
+        findCounterexampleGrids(counterexampleGrids);
+        for (int id: counterexampleGrids) {
+            if (gridTree[gridNode[id]].depth < maxDepth) {
+                refinementGrids.push_back(id);
+            }
+        }
+        if (refinementGrids.size() == 0) {
+            printf("[Warning] Refinement depth limit reached.\n");
+            break;
+        }
+        dirtyGrids.clear();
+        splitGrids(refinementGrids, dirtyGrids);
+    }
+    plotGrids();
+}
+
+// Integrates every grid with and without sweeping the rounding errors. Fails if a sweeping flowpipe stops
+// where the other one completes, or if sweeping widens a reachable box by more than sweepWidthBound.
+int compareSweep() {
+    buildGrids();
+    printf("[Info] Comparing the reachable boxes with and without sweeping the rounding errors.\n");
+    double maxWidening = 0, sumWidening = 0;
+    long widthCnt = 0, failCnt = 0;
+    startProgress("Compare", grids.size() * 2);
+    for (int id = 0; id < grids.size(); id++) {
+        for (int meet = 0; meet < 2; meet++) {
+            vector<Interval> box, sweptBox;
+            roundingErrorSweep = false;
+            bool completed = integrateGrid(grids[id], meet, box);
+            roundingErrorSweep = true;
+            bool sweptCompleted = integrateGrid(grids[id], meet, sweptBox);
+            if (completed && !sweptCompleted) {
+                failCnt++;
+            } else if (completed) {
+                for (int i = 0; i < xcnt && box[i].width() > 0; i++) {
+                    double widening = sweptBox[i].width() / box[i].width() - 1;
+                    maxWidening = max(maxWidening, widening);
+                    sumWidening += widening;
+                    widthCnt++;
+                }
+            }
+            progressDone++;
+        }
+    }
+    stopProgress();
+    printf("       Relative widening: mean %.3g, max %.3g, bound %.3g\n", widthCnt ? sumWidening / widthCnt : 0, maxWidening, sweepWidthBound);
+    if (failCnt > 0) {
+        printf("[Error] %ld flowpipes stop only when the rounding errors are swept.\n", failCnt);
+        return 1;
+    }
+    if (!(maxWidening <= sweepWidthBound)) {
+        printf("[Error] Sweeping the rounding errors widens a reachable box by more than the bound.\n");
+        return 1;
+    }
+    printf("[Success] Sweeping the rounding errors keeps every reachable box within the bound.\n");
+    return 0;
+}
+
+string resultPath(int gridCount) {
+    sprintf(buf, "%s%016llx_%d.bin", resultDir.c_str(), modelHash(), gridCount);
+    return buf;
+}
+
+// flags per grid: 1: integrated, 2: safe without meeting, 4: safe with meeting, followed by the safe boxes
+void saveResults() {
+    mkdir(resultDir.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    string path = resultPath(d);
+    string tmpPath;
+    FILE *file = openTemp(path, tmpPath);
+    if (!file) {
+        printf("[Warning] Can not write the results to %s.\n", path.c_str());
+        return;
+    }
+    fwrite(&xcnt, sizeof(int), 1, file);
+    fwrite(&d, sizeof(int), 1, file);
+    for (int id = 0; id < grids.size(); id++) {
+        unsigned char flags = integrated.test(id);
+        for (int meet = 0; meet < 2; meet++) {
+            if (reachBoxes[id][meet].size()) {
+                flags |= 2 << meet;
+            }
+        }
+        fwrite(&flags, 1, 1, file);
+        for (int meet = 0; meet < 2; meet++) {
+            for (Interval &dim: reachBoxes[id][meet]) {
+                double bound[2] = {dim.inf(), dim.sup()};
+                fwrite(bound, sizeof(double), 2, file);
+            }
+        }
+    }
+    fclose(file);
+    rename(tmpPath.c_str(), path.c_str());
+    printf("[Info] Results saved to %s.\n", path.c_str());
+}
+
+bool loadResults(int gridCount, vector<vector<vector<Interval>>> &boxes, dynamic_bitset<> &done) {
+    FILE *file = fopen(resultPath(gridCount).c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    int dim = 0, cnt = 0;
+    bool valid = fread(&dim, sizeof(int), 1, file) == 1 && fread(&cnt, sizeof(int), 1, file) == 1;
+    valid = valid && dim == xcnt && cnt == gridCount;
+    int n = 1;
+    for (int i = 0; valid && i < xcnt; i++) {
+        n *= gridCount;
+    }
+    boxes.assign(n, vector<vector<Interval>>(2));
+    done.resize(n);
+    for (int id = 0; valid && id < n; id++) {
+        unsigned char flags;
+        valid = fread(&flags, 1, 1, file) == 1;
+        done[id] = flags & 1;
+        for (int meet = 0; valid && meet < 2; meet++) {
+            if (!(flags & (2 << meet))) continue;
+            for (int i = 0; valid && i < xcnt; i++) {
+                double bound[2];
+                valid = fread(bound, sizeof(double), 2, file) == 2;
+                boxes[id][meet].push_back(Interval(bound[0], bound[1]));
+            }
+        }
+    }
+    fclose(file);
+    return valid;
+}
+
+// A grid is covered by the coarse grids in index range [i * coarse / d, ((i + 1) * coarse - 1) / d]
+// of every dimension, so the hull of their boxes bounds its reachable states.
+void inheritResults(int coarse, vector<vector<vector<Interval>>> &coarseBoxes) {
+    for (int id = 0; id < grids.size(); id++) {
+        vector<int> lo(xcnt), hi(xcnt);
+        for (int i = xcnt - 1, rest = id; i >= 0; i--, rest /= d) {
+            long long index = rest % d;
+            lo[i] = index * coarse / d;
+            hi[i] = ((index + 1) * coarse - 1) / d;
+        }
+        reachBoxes[id].assign(2, vector<Interval>());
+        for (int meet = 0; meet < 2; meet++) {
+            bool safe = true;
+            vector<int> cur = lo;
+            while (safe) {
+                int coarseId = 0;
+                for (int i = 0; i < xcnt; i++) {
+                    coarseId = coarseId * coarse + cur[i];
+                }
+                vector<Interval> &box = coarseBoxes[coarseId][meet];
+                if (box.size() == 0) {
+                    safe = false;
+                } else if (reachBoxes[id][meet].size() == 0) {
+                    reachBoxes[id][meet] = box;
+                } else {
+                    for (int i = 0; i < xcnt; i++) {
+                        reachBoxes[id][meet][i].hull_assign(box[i]);
+                    }
+                }
+                int i = xcnt - 1;
+                while (i >= 0 && cur[i] == hi[i]) {
+                    cur[i] = lo[i];
+                    i--;
+                }
+                if (i < 0) break;
+                cur[i]++;
+            }
+            if (!safe) {
+                reachBoxes[id][meet].clear();
+            }
+        }
+    }
+}
+
+void loadStoredResults() {
+    // The same grid count first, then the finest coarser one, preferring divisors of d.
+    vector<int> gridCounts;
+    for (int res = d; res >= 1; res--) {
+        if (d % res == 0) gridCounts.push_back(res);
+    }
+    for (int res = d - 1; res >= 1; res--) {
+        if (d % res != 0) gridCounts.push_back(res);
+    }
+    for (int res: gridCounts) {
+        vector<vector<vector<Interval>>> boxes;
+        dynamic_bitset<> done;
+        if (!loadResults(res, boxes, done)) continue;
+        if (res == d) {
+            reachBoxes = boxes;
+            integrated = done;
+        } else {
+            inheritResults(res, boxes);
+        }
+        reachDone.set();
+        printf("[Info] Reusing results of %d grids per dimension.\n", res);
+        return;
+    }
+}
+
+void runMultiResolution() {
+    buildGrids();
+    int n = grids.size();
+    for (int id = 0; id < n; id++) {
+        gridTree.push_back({grids[id], id, -1, 0});
+        gridNode.push_back(id);
+    }
+    reachBoxes.resize(n);
+    reachDone.resize(n);
+    integrated.resize(n);
+    loadStoredResults();
+    vector<int> dirtyGrids;
+    for (int id = 0; id < n; id++) {
+        dirtyGrids.push_back(id);
+    }
+    while (true) {
+        for (int id: dirtyGrids) {
+            if (!reachDone.test(id)) {
+                integrated.set(id);
+            }
+        }
+        buildAdaptiveOneStepGraph(dirtyGrids);
+        revKStepGraph.clear();
+        Ts.clear();
+        Tk.clear();
+        Ti.clear();
+        buildKStepGraph();
+        findLargestClosedSubgraph();
+        if (checkSafety()) {
+            break;
+        }
+        // Inherited boxes are coarse, compute the grids the result depends on by themselves.
+        vector<int> counterexampleGrids;
+        findCounterexampleGrids(counterexampleGrids);
+        dirtyGrids.clear();
+        for (int id: counterexampleGrids) {
+            if (!integrated.test(id)) {
+                reachDone.reset(id);
+                dirtyGrids.push_back(id);
+            }
+        }
+        if (dirtyGrids.size() == 0) {
+            break;
+        }
+        printf("[Info] Recomputing %d grids.\n", (int)dirtyGrids.size());
+    }
+    saveResults();
+    writeGraphFile();
+    plotGrids();
+}
+
+void buildTiers() {
+    // Half of the order first, then the configured one, then a higher order with half of the step size.
+    if (max(2, order / 2) < order) {
+        tiers.push_back({max(2, order / 2), stepSize});
+    }
+    tiers.push_back({order, stepSize});
+    tiers.push_back({order + 2, stepSize / 2});
+}
+
+void applyTier(int tier) {
+    setting.setFixedStepsize(tiers[tier].second, tiers[tier].first);
+    sprintf(buf, "%d %.17g\n", tiers[tier].first, tiers[tier].second);
+    settingKey = buf;
+    setting.prepare();
+}
+
+void runTiered() {
+    buildGrids();
+    int n = grids.size();
+    for (int id = 0; id < n; id++) {
+        gridTree.push_back({grids[id], id, -1, 0});
+        gridNode.push_back(id);
+    }
+    buildTiers();
+    gridTier.assign(n, 0);
+    vector<int> dirtyGrids;
+    for (int id = 0; id < n; id++) {
+        dirtyGrids.push_back(id);
+    }
+    printf("[Info] Tier 0: order %d, step size %g, %d grids.\n", tiers[0].first, tiers[0].second, n);
+    applyTier(0);
+    buildAdaptiveOneStepGraph(dirtyGrids);
+    while (true) {
+        revKStepGraph.clear();
+        Ts.clear();
+        Tk.clear();
+        Ti.clear();
+        buildKStepGraph();
+        findLargestClosedSubgraph();
+        if (checkSafety()) {
+            break;
+        }
+        // Only the grids the unsafe result depends on move to the next tier.
+        vector<int> counterexampleGrids;
+        findCounterexampleGrids(counterexampleGrids);
+        vector<vector<int>> escalated(tiers.size());
+        bool escalate = false;
+        for (int id: counterexampleGrids) {
+            if (gridTier[id] + 1 < tiers.size()) {
+                gridTier[id]++;
+                escalated[gridTier[id]].push_back(id);
+                escalate = true;
+            }
+        }
+        if (!escalate) {
+            printf("[Warning] Highest tier reached.\n");
+            break;
+        }
+        for (int tier = 1; tier < tiers.size(); tier++) {
+            if (escalated[tier].size() == 0) continue;
+            printf("[Info] Tier %d: order %d, step size %g, %d grids.\n",
+                tier, tiers[tier].first, tiers[tier].second, (int)escalated[tier].size());
+            applyTier(tier);
+            for (int id: escalated[tier]) {
+                reachDone.reset(id);
+            }
+            buildAdaptiveOneStepGraph(escalated[tier]);
+        }
+    }
+    vector<int> tierCnt(tiers.size());
+    for (int id = 0; id < n; id++) {
+        tierCnt[gridTier[id]]++;
+    }
+    printf("[Success] Grids per tier:\n");
+    for (int tier = 0; tier < tiers.size(); tier++) {
+        printf("          Order %d, step size %g: %d\n", tiers[tier].first, tiers[tier].second, tierCnt[tier]);
+    }
+    writeGraphFile();
+    plotGrids();
+}
+
+// The options which only concern a single run. The other options and the files they name
+// decide the parsed model and the Flow* setting, which a served job may inherit.
+const vector<pair<string, int>> runOptions = {{"--shard", 1}, {"--output", 1}, {"--report", 1}, {"--checkpoint", 0}, {"--resume", 0}, {"--time-limit", 1}};
+
+void resetRunOptions() {
+    shardId = 0;
+    shardCnt = 1;
+    reportPath.clear();
+    checkpointMode = false;
+    resumeMode = false;
+    timeLimit = 0;
+}
+
+bool parseRunOption(int argc, char** argv, int &i) {
+    if (!strcmp(argv[i], "--shard") && i + 1 < argc) {
+        sscanf(argv[++i], "%d/%d", &shardId, &shardCnt);
+    } else if (!strcmp(argv[i], "--output") && i + 1 < argc) {
+        outputPath = argv[++i];
+    } else if (!strcmp(argv[i], "--report") && i + 1 < argc) {
+        reportPath = argv[++i];
+    } else if (!strcmp(argv[i], "--checkpoint")) {
+        checkpointMode = true;
+    } else if (!strcmp(argv[i], "--resume")) {
+        resumeMode = true;
+    } else if (!strcmp(argv[i], "--time-limit") && i + 1 < argc) {
+        timeLimit = atof(argv[++i]);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void applyRunOptions(int argc, char** argv) {
+    resetRunOptions();
+    for (int i = 1; i < argc; i++) {
+        parseRunOption(argc, argv, i);
+    }
+}
+
+// Parses the arguments and the model, and sets up Flow*. false if a file can not be read.
+bool prepareRun(int argc, char** argv) {
+    char *modelPath = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (i == 1 && !strcmp(argv[i], "merge")) {
+            mergeMode = true;
+        } else if (parseRunOption(argc, argv, i)) {
+            continue;
+        } else if (!strcmp(argv[i], "--axes") && i + 2 < argc) {
+            plotAxisNames[0] = argv[++i];
+            plotAxisNames[1] = argv[++i];
+        } else if (!strcmp(argv[i], "--slice") && i + 1 < argc) {
+            char *value = strchr(argv[++i], '=');
+            if (value) {
+                plotSliceNames.push_back({string(argv[i], value), atof(value + 1)});
+            }
+        } else if (!strcmp(argv[i], "--load")) {
+            loadMode = true;
+        } else if (!strcmp(argv[i], "--verdict")) {
+            verdictMode = true;
+        } else if (!strcmp(argv[i], "--adaptive") && i + 1 < argc) {
+            adaptiveMode = true;
+            maxDepth = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--no-symmetry")) {
+            symmetryMode = false;
+        } else if (!strcmp(argv[i], "--multires")) {
+            multiResMode = true;
+        } else if (!strcmp(argv[i], "--cache")) {
+            cacheMode = true;
+        } else if (!strcmp(argv[i], "--cache-dir") && i + 1 < argc) {
+            cacheMode = true;
+            cacheDir = argv[++i];
+            if (cacheDir.back() != '/') {
+                cacheDir += '/';
+            }
+        } else if (!strcmp(argv[i], "--cache-limit") && i + 1 < argc) {
+            cacheSizeLimit = atof(argv[++i]) * (1 << 20);
+        } else if (!strcmp(argv[i], "--no-cache")) {
+            cacheMode = false;
+        } else if (!strcmp(argv[i], "--tiered")) {
+            tieredMode = true;
+        } else if (!strcmp(argv[i], "--sweep-rounding")) {
+            roundingErrorSweep = true;
+        } else if (!strcmp(argv[i], "--compare-sweep")) {
+            compareSweepMode = true;
+            roundingErrorSweep = true;  // fixed steps, the Float coefficients only apply to them
+        } else if (!strcmp(argv[i], "--adaptive-step")) {
+            adaptiveStepMode = true;
+        } else if (!strcmp(argv[i], "--refine-tolerance") && i + 1 < argc) {
+            refineTolerance = atof(argv[++i]);
+        } else {
+            modelPath = argv[i];
+        }
+    }
+    reportModel = modelPath ? modelPath : "";
+    if (!parseModel(modelPath) || !buildFlowstar()) {
+        return false;
+    }
+    detectSymmetry();
+    return true;
+}
+
+// Everything after prepareRun, which only changes the globals of this run.
+int finishRun() {
+    if (shardCnt < 1 || shardId < 0 || shardId >= shardCnt) {
+        printf("[Error] Invalid shard %d/%d.\n", shardId, shardCnt);
+        return 1;
+    }
+    if (compareSweepMode) {
+        return compareSweep();
+    }
+    openCache();
+    if (verdictMode) {
+        checkVerdict();
+        return 0;
+    }
+    if (adaptiveMode) {
+        runAdaptive();
+        return 0;
+    }
+    if (multiResMode) {
+        runMultiResolution();
+        return 0;
+    }
+    if (tieredMode) {
+        runTiered();
+        return 0;
+    }
+    buildGrids();
+    if (loadMode) {
+        if (!loadGraphFile()) {
+            return 1;
+        }
+        checkSafety();
+        plotGrids();
+        return 0;
+    }
+    if (mergeMode) {
+        if (!mergeShards()) {
+            return 1;
+        }
+    } else {
+        buildOneStepGraph();
+        if (shardCnt > 1) {
+            printf("[Success] Shard %d/%d written to %s.\n", shardId, shardCnt, checkpointPath().c_str());
+            return 0;
+        }
+    }
+    buildKStepGraph();
+    findLargestClosedSubgraph();
+    checkSafety();
+    writeGraphFile();
+    plotGrids();
+    return 0;
+}
+
+long countEdges(vector<vector<int>> &graph) {
+    long edges = 0;
+    for (auto &nextIds: graph) {
+        edges += nextIds.size();
+    }
+    return edges;
+}
+
+void writeReport(int status, double wall, double cpu) {
+    const char *verdict = status ? "failed" : jobResult == 1 ? "safe" : jobResult == 2 ? "unsafe" : "none";
+    long oneStepEdges = 0, kStepEdges = countEdges(revKStepGraph);
+    for (auto &edges: oneStepGraph) {
+        oneStepEdges += countEdges(edges);
+    }
+    if (loadMode) {
+        oneStepEdges = loadedEdges[0];
+        kStepEdges = loadedEdges[1];
+    }
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    vector<pair<string, double>> fields = {
+        {"grid_count", (double)grids.size()},
+        {"one_step_edges", (double)oneStepEdges},
+        {"k_step_edges", (double)kStepEdges},
+        {"start_region", (double)Ts.count()},
+        {"end_region", (double)Tk.count()},
+        {"safe_region", (double)Ti.count()},
+        {"flowpipes", (double)flowpipeCnt},
+        {"cache_hits", (double)cacheHitCnt},
+        {"refinement_steps", (double)refinementStats.steps},
+        {"refinement_iterations", (double)refinementStats.iterations},
+        {"refinement_early_exits", (double)refinementStats.early_exits},
+        {"refinement_capped", (double)refinementStats.capped},
+        {"refinement_extrapolations", (double)refinementStats.extrapolations},
+        {"refinement_failed_extrapolations", (double)refinementStats.failed_extrapolations},
+        {"adaptive_steps", (double)stepsizeStats.accepted},
+        {"rejected_steps", (double)stepsizeStats.rejected},
+        {"cells_per_second", phaseWall[PHASE_ONE_STEP] > 0 ? flowpipeCnt / phaseWall[PHASE_ONE_STEP] : 0},
+        {"peak_rss_kb", (double)usage.ru_maxrss},
+        {"wall", wall},
+        {"cpu", cpu},
+    };
+    bool csv = reportPath.size() >= 4 && reportPath.compare(reportPath.size() - 4, 4, ".csv") == 0;
+    FILE *file = fopen(reportPath.c_str(), csv ? "a" : "w");
+    if (!file) {
+        printf("[Warning] Can not write the report to %s.\n", reportPath.c_str());
+        return;
+    }
+    if (csv) {
+        // the header is written once, every run appends a row
+        if (ftell(file) == 0) {
+            fprintf(file, "model,model_hash,d,m,k,verdict");
+            for (auto &field: fields) {
+                fprintf(file, ",%s", field.first.c_str());
+            }
+            for (int phase = 0; phase < PHASE_CNT; phase++) {
+                fprintf(file, ",%s_wall,%s_cpu", phaseNames[phase], phaseNames[phase]);
+            }
+            fprintf(file, "\n");
+        }
+        fprintf(file, "%s,%016llx,%d,%d,%d,%s", reportModel.c_str(), modelHash(), d, m, k, verdict);
+        for (auto &field: fields) {
+            fprintf(file, ",%.9g", field.second);
+        }
+        for (int phase = 0; phase < PHASE_CNT; phase++) {
+            fprintf(file, ",%.9g,%.9g", phaseWall[phase], phaseCpu[phase]);
+        }
+        fprintf(file, "\n");
+    } else {
+        fprintf(file, "{\n");
+        fprintf(file, "  \"model\": \"%s\",\n", reportModel.c_str());
+        fprintf(file, "  \"model_hash\": \"%016llx\",\n", modelHash());
+        fprintf(file, "  \"d\": %d,\n  \"m\": %d,\n  \"k\": %d,\n", d, m, k);
+        fprintf(file, "  \"verdict\": \"%s\",\n", verdict);
+        fprintf(file, "  \"phases\": {\n");
+        for (int phase = 0; phase < PHASE_CNT; phase++) {
+            fprintf(file, "    \"%s\": {\"wall\": %.9g, \"cpu\": %.9g}%s\n", phaseNames[phase], phaseWall[phase], phaseCpu[phase],
+                phase + 1 < PHASE_CNT ? "," : "");
+        }
+        fprintf(file, "  },\n");
+        for (int i = 0; i < fields.size(); i++) {
+            fprintf(file, "  \"%s\": %.9g%s\n", fields[i].first.c_str(), fields[i].second, i + 1 < fields.size() ? "," : "");
+        }
+        fprintf(file, "}\n");
+    }
+    fclose(file);
+}
+
+// The model is parsed by prepareRun before, unless prepared is false.
+int runJob(int argc, char** argv, bool prepared) {
+    double wall = getTime(CLOCK_MONOTONIC), cpu = getTime(CLOCK_PROCESS_CPUTIME_ID);
+    int status = prepared || prepareRun(argc, argv) ? finishRun() : 1;
+    if (!reportPath.empty()) {
+        writeReport(status, getTime(CLOCK_MONOTONIC) - wall, getTime(CLOCK_PROCESS_CPUTIME_ID) - cpu);
+    }
+    return status;
+}
+
+const char *jobStatus(int status) {
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 0) return "done";  // no verdict, e.g. a shard
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 1) return "safe";
+    if (WIFEXITED(status) && WEXITSTATUS(status) == 2) return "unsafe";
+    return "failed";
+}
+
+void splitArguments(string &line, vector<char> &chars, vector<char *> &args) {
+    chars.assign(line.begin(), line.end());
+    chars.push_back(0);
+    args.assign(1, (char *)"saw");
+    for (char *arg = strtok(chars.data(), " \t\r\n"); arg; arg = strtok(NULL, " \t\r\n")) {
+        args.push_back(arg);
+    }
+}
+
+// The arguments of a job without the run options, and the size and time of every file they
+// name and of config.txt. Jobs with the same key can be forked from one parsed model.
+string warmKey(string &line) {
+    vector<char> chars;
+    vector<char *> args;
+    splitArguments(line, chars, args);
+    string key;
+    for (int i = 1; i < args.size(); i++) {
+        auto option = find_if(runOptions.begin(), runOptions.end(), [&](const pair<string, int> &o) { return o.first == args[i]; });
+        if (option != runOptions.end()) {
+            i += option->second;
+            continue;
+        }
+        key += args[i];
+        key += "\n";
+    }
+    args.push_back((char *)"config.txt");
+    for (int i = 1; i < args.size(); i++) {
+        struct stat st;
+        if (!stat(args[i], &st) && S_ISREG(st.st_mode)) {
+            sprintf(buf, "%s %lld %lld.%09ld\n", args[i], (long long)st.st_size, (long long)st.st_mtim.tv_sec, st.st_mtim.tv_nsec);
+            key += buf;
+        }
+    }
+    return key;
+}
+
+struct Job {
+    int id;
+    string line;
+    time_t start;
+};
+
+struct Worker {
+    pid_t pid;
+    int fd;  // packets to the worker: job id and arguments, with the client socket attached
+    string key;  // warmKey of its parsed model
+    bool busy;
+    Job job;
+};
+
+// Runs the jobs sent by the daemon one after another. The first job parses the model here,
+// and every job runs in a fork of this state, so it starts from the prepared model and clean
+// globals otherwise, and shares the cell cache with the other jobs through the cache file.
+void runWorker(int fd) {
+    static char packet[1 << 16];
+    int devNull = open("/dev/null", O_WRONLY);
+    bool prepared = false;
+    for (int jobCnt = 0; ; jobCnt++) {
+        iovec iov = {packet, sizeof(packet) - 1};
+        char control[CMSG_SPACE(sizeof(int))];
+        msghdr msg = {};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+        ssize_t len = recvmsg(fd, &msg, 0);
+        if (len < 0 && errno == EINTR) {
+            jobCnt--;
+            continue;
+        }
+        if (len < (ssize_t)sizeof(int)) {
+            exit(0);
+        }
+        packet[len] = 0;
+        int jobId;
+        memcpy(&jobId, packet, sizeof(jobId));
+        string line = packet + sizeof(jobId);
+        int client = -1;
+        cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        if (cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+            memcpy(&client, CMSG_DATA(cmsg), sizeof(client));
+        }
+
+        fflush(stdout);
+        if (client >= 0) {
+            dup2(client, STDOUT_FILENO);
+            close(client);
+            setvbuf(stdout, NULL, _IOLBF, 0);
+        } else {
+            sprintf(buf, "%sjob_%d.txt", resultDir.c_str(), jobId);
+            int file = open(buf, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            dup2(file >= 0 ? file : devNull, STDOUT_FILENO);
+            if (file >= 0) {
+                close(file);
+            }
+        }
+        vector<char> chars;
+        vector<char *> args;
+        splitArguments(line, chars, args);
+        if (!prepared) {
+            // The daemon retires a worker which exits, and reports its job as failed.
+            if (!prepareRun(args.size(), args.data())) {
+                fflush(stdout);
+                exit(1);
+            }
+            prepared = true;
+        }
+        fflush(stdout);
+        pid_t pid = fork();
+        if (pid == 0) {
+            close(fd);
+            if (jobCnt > 0) {
+                // the model was parsed for an earlier job
+                phaseWall[PHASE_PARSE] = phaseCpu[PHASE_PARSE] = 0;
+                phaseWall[PHASE_FLOWSTAR] = phaseCpu[PHASE_FLOWSTAR] = 0;
+            }
+            sprintf(buf, "%sjob_%d.svg", resultDir.c_str(), jobId);
+            outputPath = buf;
+            applyRunOptions(args.size(), args.data());
+            int status = runJob(args.size(), args.data(), true);
+            fflush(stdout);
+            exit(status ? 3 : jobResult);
+        }
+        int status = 0;
+        if (pid < 0) {
+            status = 3 << 8;
+        } else {
+            while (waitpid(pid, &status, 0) < 0 && errno == EINTR);
+        }
+        // Let the client see the end of the output.
+        fflush(stdout);
+        dup2(devNull, STDOUT_FILENO);
+        while (write(fd, &status, sizeof(status)) < 0 && errno == EINTR);
+    }
+}
+
+void spawnWorker(vector<Worker> &workers, int server, int client, string &key) {
+    int fds[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds)) {
+        return;
+    }
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        // Only the daemon holds the sockets, or a client would wait for the end of this worker.
+        if (server >= 0) {
+            close(server);
+        }
+        if (client >= 0) {
+            close(client);
+        }
+        for (Worker &worker: workers) {
+            close(worker.fd);
+        }
+        runWorker(fds[1]);
+    }
+    close(fds[1]);
+    if (pid < 0) {
+        close(fds[0]);
+        return;
+    }
+    workers.push_back({pid, fds[0], key, false, {}});
+}
+
+void retireWorker(vector<Worker> &workers, int index) {
+    close(workers[index].fd);
+    while (waitpid(workers[index].pid, NULL, 0) < 0 && errno == EINTR);
+    workers.erase(workers.begin() + index);
+}
+
+// An idle worker holding the model of the job, or a new one in place of an idle worker
+// holding another model. -1 if every worker is busy.
+int pickWorker(vector<Worker> &workers, int server, int client, string &key) {
+    for (int i = 0; i < workers.size(); i++) {
+        if (!workers[i].busy && workers[i].key == key) {
+            return i;
+        }
+    }
+    if (workers.size() >= jobCnt) {
+        int idle = -1;
+        for (int i = 0; i < workers.size() && idle < 0; i++) {
+            if (!workers[i].busy) {
+                idle = i;
+            }
+        }
+        if (idle < 0) {
+            return -1;
+        }
+        retireWorker(workers, idle);
+    }
+    spawnWorker(workers, server, client, key);
+    return workers.size() && workers.back().key == key && !workers.back().busy ? workers.size() - 1 : -1;
+}
+
+bool idleSlot(vector<Worker> &workers) {
+    return workers.size() < jobCnt || any_of(workers.begin(), workers.end(), [](const Worker &worker) { return !worker.busy; });
+}
+
+void finishJob(Worker &worker, int status) {
+    printf("[Job %d] %s: %s, %lds\n", worker.job.id, worker.job.line.c_str(), jobStatus(status), (long)(time(NULL) - worker.job.start));
+    fflush(stdout);
+    worker.busy = false;
+}
+
+// Reads the job line of a connection. A client sending nothing within clientTimeout seconds
+// is dropped, so it can not hold up the other clients.
+const int clientTimeout = 10;
+
+bool readJobLine(int client, string &line) {
+    timeval timeout = {clientTimeout, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    char c;
+    while (true) {
+        ssize_t len = read(client, &c, 1);
+        if (len < 0 && errno == EINTR) {
+            continue;
+        }
+        if (len != 1) {
+            return false;
+        }
+        if (c == '\n') {
+            break;
+        }
+        line += c;
+    }
+    line.erase(line.find_last_not_of(" \t\r") + 1);
+    timeout = {0, 0};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    return !line.empty();
+}
+
+// One job per line of stdin, or per connection of the socket, with the arguments of saw.
+int serve() {
+    mkdir(resultDir.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH);
+    if (jobCnt <= 0) {
+        jobCnt = max(1L, sysconf(_SC_NPROCESSORS_ONLN));
+    }
+    int server = -1;
+    if (socketPath) {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path) - 1);
+        unlink(socketPath);
+        server = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (server < 0 || bind(server, (sockaddr *)&addr, sizeof(addr)) || listen(server, 64)) {
+            printf("[Error] Can not listen on %s.\n", socketPath);
+            return 1;
+        }
+        printf("[Info] Serving on %s with %d jobs.\n", socketPath, jobCnt);
+    } else {
+        printf("[Info] Reading jobs from stdin with %d jobs.\n", jobCnt);
+    }
+    fflush(stdout);
+    signal(SIGPIPE, SIG_IGN);
+    vector<Worker> workers;
+    string input;  // stdin read so far
+    bool inputOpen = true;
+    int jobId = 0;
+    while (inputOpen || any_of(workers.begin(), workers.end(), [](const Worker &worker) { return worker.busy; })) {
+        // Take a new job only if a worker can start it.
+        bool stdinLine = !socketPath && input.find('\n') != string::npos;
+        bool wantInput = inputOpen && idleSlot(workers) && !stdinLine;
+        vector<pollfd> fds;
+        for (Worker &worker: workers) {
+            fds.push_back({worker.fd, POLLIN, 0});
+        }
+        if (wantInput) {
+            fds.push_back({socketPath ? server : STDIN_FILENO, POLLIN, 0});
+        }
+        if (!(stdinLine && idleSlot(workers)) && poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno != EINTR) {
+                printf("[Error] poll failed.\n");
+                return 1;
+            }
+            continue;
+        }
+        for (int i = workers.size() - 1; i >= 0; i--) {
+            if (!(fds[i].revents & (POLLIN | POLLHUP | POLLERR))) continue;
+            int status;
+            ssize_t len = read(workers[i].fd, &status, sizeof(status));
+            if (len < 0 && errno == EINTR) continue;
+            if (len == sizeof(status)) {
+                finishJob(workers[i], status);
+            } else {
+                // The worker died, e.g. on a model it can not parse.
+                if (workers[i].busy) {
+                    finishJob(workers[i], -1);
+                }
+                retireWorker(workers, i);
+            }
+        }
+
+        string line;
+        int client = -1;
+        if (socketPath) {
+            if (!wantInput || !(fds.back().revents & POLLIN)) continue;
+            client = accept(server, NULL, NULL);
+            if (client < 0) continue;
+            if (!readJobLine(client, line)) {
+                close(client);
+                continue;
+            }
+        } else {
+            if (wantInput && (fds.back().revents & (POLLIN | POLLHUP))) {
+                ssize_t len = read(STDIN_FILENO, buf, BUFSIZE);
+                if (len < 0 && errno == EINTR) continue;
+                if (len <= 0) {
+                    inputOpen = false;
+                    if (!input.empty()) {
+                        input += '\n';
+                    }
+                } else {
+                    input.append(buf, len);
+                }
+            }
+            size_t end = input.find('\n');
+            if (end == string::npos || !idleSlot(workers)) continue;
+            line = input.substr(0, end);
+            input.erase(0, end + 1);
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (line.empty()) continue;
+        }
+
+        jobId++;
+        string key = warmKey(line);
+        int index = pickWorker(workers, server, client, key);
+        if (index >= 0) {
+            Worker &worker = workers[index];
+            vector<char> packet(sizeof(jobId));
+            memcpy(packet.data(), &jobId, sizeof(jobId));
+            packet.insert(packet.end(), line.begin(), line.end());
+            iovec iov = {packet.data(), packet.size()};
+            char control[CMSG_SPACE(sizeof(int))] = {};
+            msghdr msg = {};
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            if (client >= 0) {
+                msg.msg_control = control;
+                msg.msg_controllen = sizeof(control);
+                cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+                cmsg->cmsg_level = SOL_SOCKET;
+                cmsg->cmsg_type = SCM_RIGHTS;
+                cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+                memcpy(CMSG_DATA(cmsg), &client, sizeof(client));
+            }
+            ssize_t sent;
+            while ((sent = sendmsg(worker.fd, &msg, 0)) < 0 && errno == EINTR);
+            if (sent == (ssize_t)packet.size()) {
+                worker.busy = true;
+                worker.job = {jobId, line, time(NULL)};
+            } else {
+                index = -1;
+            }
+        }
+        if (index < 0) {
+            printf("[Error] Can not start job %d.\n", jobId);
+            fflush(stdout);
+        }
+        if (client >= 0) {
+            close(client);
+        }
+    }
+    while (workers.size()) {
+        retireWorker(workers, workers.size() - 1);
+    }
+    return 0;
+}
+
+// Sends the arguments as one job to the daemon and prints its output.
+int runClient(int argc, char** argv) {
+    if (argc < 4) {
+        printf("[Error] Usage: saw client <socket> <model> [options]\n");
+        return 1;
+    }
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, argv[2], sizeof(addr.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, (sockaddr *)&addr, sizeof(addr))) {
+        printf("[Error] Can not connect to %s.\n", argv[2]);
+        return 1;
+    }
+    string line;
+    for (int i = 3; i < argc; i++) {
+        line += argv[i];
+        line += i + 1 < argc ? " " : "\n";
+    }
+    write(fd, line.data(), line.size());
+    int len;
+    while ((len = read(fd, buf, BUFSIZE)) > 0) {
+        fwrite(buf, 1, len, stdout);
+        fflush(stdout);
+    }
+    close(fd);
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && !strcmp(argv[1], "client")) {
+        return runClient(argc, argv);
+    }
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--serve")) {
+            serveMode = true;
+        } else if (!strcmp(argv[i], "--socket") && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (!strcmp(argv[i], "--jobs") && i + 1 < argc) {
+            jobCnt = atoi(argv[++i]);
+        }
+    }
+    if (serveMode) {
+        return serve();
+    }
+    return runJob(argc, argv, false);
 }
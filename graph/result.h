@@ -0,0 +1,42 @@
+#ifndef SAW_RESULT_H
+#define SAW_RESULT_H
+
+#include <stdint.h>
+
+// Layout of the binary result file written to results/<model hash>_<d>_<m>_<k>.graph.
+// Every section starts at an 8-byte aligned offset from the beginning of the file,
+// so the file can be mapped and read in place.
+//
+// safeState        2 * xcnt doubles, inf and sup of every dimension
+// oneStepIndex[i]  gridCnt + 1 uint64, edges of grid id are oneStepEdges[i][index[id], index[id + 1])
+// oneStepEdges[i]  uint32 grid ids, i = 0: missing the deadline, 1: meeting it
+// kStepIndex       gridCnt + 1 uint64, same as above for the K-step graph from the grids in Ts
+// kStepEdges       uint32 grid ids
+// Ts, Tk, Ti       (gridCnt + 63) / 64 uint64, bit id % 64 of word id / 64 is grid id
+
+#define RESULT_MAGIC "SAWGRAPH"
+#define RESULT_VERSION 1
+
+struct ResultHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t xcnt;
+    uint32_t d;
+    uint32_t m;
+    uint32_t k;
+    uint32_t gridCnt;
+    uint64_t modelHash;
+
+    // byte offsets of the sections
+    uint64_t safeState;
+    uint64_t oneStepIndex[2];
+    uint64_t oneStepEdges[2];
+    uint64_t kStepIndex;
+    uint64_t kStepEdges;
+    uint64_t Ts;
+    uint64_t Tk;
+    uint64_t Ti;
+    uint64_t size;
+};
+
+#endif